@@ -4,6 +4,9 @@
 #include <algorithm>
 #include <chrono>
 #include <cassert>
+#include <mutex>
+#include <climits>
+#include <limits>
 
 using namespace std;
 using chrono::steady_clock;
@@ -15,28 +18,97 @@ using chrono::duration;
  * Salida: Instancia de la clase inicializada.
  */
 ALNS::ALNS(const Parser* parser, CbcSolver* cbc)
-    : parserData(parser), cbcSolver(cbc), vns(parser), rng(42) {}
+    : parserData(parser), cbcSolver(cbc), vns(parser), rng(SEED) {}
+
+// Definido aquí porque CbcSolver sólo está declarado en ALNS.h
+ALNS::~ALNS() {}
 
 /*
  * Descripción: Bucle principal de optimización. Alterna heurísticas de destrucción con reparación 
  * exacta MIP. Utiliza un esquema de aceptación basado en Recocido Simulado (SA) 
- * para escapar de óptimos locales.
+ * para escapar de óptimos locales. Con varios hilos lanza un trabajador por hilo sobre
+ * el mismo punto de partida, cada uno con su semilla y su VNS de pulido.
  * Entrada: Solución base (initialSol), límite de tiempo de ejecución en segundos.
  * Salida: La mejor solución factible encontrada durante el ciclo.
  */
 Solution ALNS::optimize(const Solution& initialSol, double timeLimitSeconds) {
     auto startTime = steady_clock::now();
+    const int maxDestroySize = min(16, parserData->getDimension() / 4);
+
+    cout << "[ALNS] Inicio | Costo: " << initialSol.getTotalCost()
+         << " | destroySize dinamico: 6 a " << maxDestroySize;
+    if (numThreads > 1) cout << " | Hilos: " << numThreads;
+    cout << endl;
+
+    Solution  bestSol   = initialSol;
+    long long iteration = 0;
+
+    long long lookupsBefore, hitsBefore;
+    cacheStats(lookupsBefore, hitsBefore);
+
+    if (numThreads == 1) {
+        bestSol = search(initialSol, startTime, timeLimitSeconds, nullptr, iteration);
+    } else {
+        prepareWorkers();
+        SharedSearch shared(initialSol);
+
+        pool->run(pool->size(), [&](int task, int worker) {
+            ALNS& alnsWorker = *workers[worker];
+            alnsWorker.rng.seed(SEED + task);
+
+            long long workerIterations = 0;
+            alnsWorker.search(initialSol, startTime, timeLimitSeconds, &shared, workerIterations);
+
+            lock_guard<mutex> lock(shared.mtx);
+            shared.iterations += workerIterations;
+        });
+
+        bestSol   = shared.best;
+        iteration = shared.iterations;
+    }
+
+    double totalTime = duration<double>(steady_clock::now() - startTime).count();
+    long long lookups, hits;
+    cacheStats(lookups, hits);
+    lookups -= lookupsBefore;
+    hits    -= hitsBefore;
+
+    cout << "[ALNS] Fin | Mejor costo: " << bestSol.getTotalCost()
+         << " | Iteraciones: " << iteration
+         << " | Tiempo: " << totalTime << "s" << endl;
+    cout << "[ALNS] Cache subproblemas CBC | Aciertos: " << hits << "/" << lookups
+         << " (" << (lookups > 0 ? 100.0 * hits / lookups : 0.0) << "%)" << endl;
+
+    return bestSol;
+}
+
+/*
+ * Descripción: Ciclo destroy / reparación CBC / pulido VNS / aceptación SA de un trabajador.
+ * En modo paralelo publica cada nuevo óptimo en el incumbente compartido y, cada
+ * SYNC_INTERVAL iteraciones, promedia sus pesos con los comunes y adopta el incumbente si
+ * otro trabajador encontró algo mejor.
+ * Entrada: Solución base, instante de inicio, límite de tiempo en segundos, estado compartido
+ * (nullptr en modo secuencial), contador de iteraciones (salida).
+ * Salida: Mejor solución encontrada por este trabajador.
+ */
+Solution ALNS::search(const Solution& initialSol, Clock::time_point startTime,
+                      double timeLimitSeconds, SharedSearch* shared, long long& iteration) {
+    auto deadline  = startTime + chrono::duration_cast<steady_clock::duration>(duration<double>(timeLimitSeconds));
     double bigM = initialSol.getTotalCost() * 0.5;
     
     Solution bestSol    = initialSol;
     Solution currentSol = initialSol;
 
-    int iteration = 0;
+    iteration = 0;
 
     vector<double> weights   = {1.0, 1.0, 1.0};
     vector<int>    successes = {0,   0,   0  };
     vector<int>    attempts  = {0,   0,   0  };
 
+    vector<double> repairWeights(NUM_REPAIRS, 1.0);
+    vector<int>    repairSuccesses(NUM_REPAIRS, 0);
+    vector<int>    repairAttempts(NUM_REPAIRS, 0);
+
     double T_start = initialSol.getTotalCost() * 0.05; 
     double T_end   = 0.1;
 
@@ -45,26 +117,19 @@ Solution ALNS::optimize(const Solution& initialSol, double timeLimitSeconds) {
     int noImprovementCounter = 0;
     const int MAX_NO_IMPROVE = 15; 
 
-    cout << "[ALNS] Inicio | Costo: " << bestSol.getTotalCost()
-         << " | destroySize dinamico: " << currentDestroySize << " a " << maxDestroySize << endl;
-
     while (true) {
         double elapsed = duration<double>(steady_clock::now() - startTime).count();
         if (elapsed >= timeLimitSeconds) break;
 
         iteration++;
 
-        // ── 1. Seleccionar operador destroy adaptativamente ──────────────
-        double totalWeight = weights[0] + weights[1] + weights[2];
-        double r = uniform_real_distribution<double>(0.0, totalWeight)(rng);
-
-        int opIdx;
-        if      (r < weights[0])               opIdx = 0; 
-        else if (r < weights[0] + weights[1])  opIdx = 1; 
-        else                                   opIdx = 2; 
-
+        // ── 1. Seleccionar operadores destroy y repair adaptativamente ───
+        int opIdx = selectOperator(weights);
         attempts[opIdx]++;
 
+        int repairIdx = selectOperator(repairWeights);
+        repairAttempts[repairIdx]++;
+
         // ── 2. Destroy ───────────────────────────────────────────────────
         vector<int> removed;
         switch (opIdx) {
@@ -75,16 +140,26 @@ Solution ALNS::optimize(const Solution& initialSol, double timeLimitSeconds) {
 
         if (removed.empty()) continue;
 
-        // ── 3. CBC Repair ────────────────────────────────────────────────
+        // ── 3. Repair (MIP exacto o inserción heurística) ────────────────
         double timeLeft = timeLimitSeconds - elapsed;
         double subproblemLimit = min(2.0, timeLeft * 0.1); 
 
-        Solution repairedSol = cbcSolver->solveSubproblem(currentSol, removed, subproblemLimit);
+        Solution repairedSol = (repairIdx == CbcRepair)
+            ? cbcSolver->solveSubproblem(currentSol, removed, subproblemLimit)
+            : regretRepair(currentSol, removed, repairIdx);
 
         if (!repairedSol.isValid()) continue;
 
-        // ── 4. VNS Polish ────────────────────────────────────────────────
-        Solution polishedSol = vns.optimize(repairedSol, vnsIter);
+        // ── 4. VNS Polish (acotado por el presupuesto y el límite global) ─
+        // Las reparaciones heurísticas tienen su propio presupuesto, más corto que el de CBC,
+        // para que todas las iteraciones se pulan sin perder su ventaja de costo
+        int polishMs = (repairIdx == CbcRepair) ? vnsBudgetMs : heuristicPolishMs;
+        Solution polishedSol = repairedSol;
+        if (polishMs > 0) {
+            VNS::StopCriteria polishStop;
+            polishStop.deadline = min(deadline, steady_clock::now() + chrono::milliseconds(polishMs));
+            polishedSol = vns.optimize(repairedSol, vnsIter, polishStop);
+        }
 
         // ── 5. Aceptación (Simulated Annealing) ──────────────────────────
         double currentCost = currentSol.getTotalCost();
@@ -122,12 +197,21 @@ Solution ALNS::optimize(const Solution& initialSol, double timeLimitSeconds) {
         if (accept) {
             currentSol = cleanedSol;
             successes[opIdx]++; 
+            repairSuccesses[repairIdx]++;
 
             if (newCost < bestSol.getTotalCost() - 0.01) {
                 bestSol = cleanedSol;
                 currentDestroySize = 6; 
                 noImprovementCounter = 0;
-                cout << "EN " << elapsed << "s" "   ---> [NUEVO OPTIMO GLOBAL]: " << bestSol.getTotalCost() << "\n";
+                if (!shared) {
+                    cout << "EN " << elapsed << "s" "   ---> [NUEVO OPTIMO GLOBAL]: " << bestSol.getTotalCost() << "\n";
+                } else {
+                    lock_guard<mutex> lock(shared->mtx);
+                    if (bestSol.getTotalCost() < shared->best.getTotalCost() - 0.01) {
+                        shared->best = bestSol;
+                        cout << "EN " << elapsed << "s" "   ---> [NUEVO OPTIMO GLOBAL]: " << bestSol.getTotalCost() << "\n";
+                    }
+                }
             } else {
                 noImprovementCounter++; 
             }
@@ -141,7 +225,7 @@ Solution ALNS::optimize(const Solution& initialSol, double timeLimitSeconds) {
         }
 
         // ── 6. Actualizar pesos adaptativos ──────────
-        if (iteration % 20 == 0) {
+        if (iteration % SYNC_INTERVAL == 0) {
             for (int i = 0; i < 3; i++) {
                 if (attempts[i] > 0) {
                     double successRate = (double)successes[i] / attempts[i];
@@ -150,17 +234,91 @@ Solution ALNS::optimize(const Solution& initialSol, double timeLimitSeconds) {
                 successes[i] = 0;
                 attempts[i]  = 0;
             }
+            for (int i = 0; i < NUM_REPAIRS; i++) {
+                if (repairAttempts[i] > 0) {
+                    double successRate = (double)repairSuccesses[i] / repairAttempts[i];
+                    repairWeights[i] = 0.8 * repairWeights[i] + 0.2 * (successRate + 0.1);
+                }
+                repairSuccesses[i] = 0;
+                repairAttempts[i]  = 0;
+            }
+
+            // ── 7. Sincronizar con los demás trabajadores ─────
+            if (shared) {
+                lock_guard<mutex> lock(shared->mtx);
+                for (int i = 0; i < 3; i++) {
+                    shared->weights[i] = 0.5 * (shared->weights[i] + weights[i]);
+                    weights[i] = shared->weights[i];
+                }
+                for (int i = 0; i < NUM_REPAIRS; i++) {
+                    shared->repairWeights[i] = 0.5 * (shared->repairWeights[i] + repairWeights[i]);
+                    repairWeights[i] = shared->repairWeights[i];
+                }
+                if (shared->best.getTotalCost() < bestSol.getTotalCost() - 0.01) {
+                    bestSol    = shared->best;
+                    currentSol = bestSol;
+                    currentDestroySize   = 6;
+                    noImprovementCounter = 0;
+                }
+            }
         }
     }
 
-    double totalTime = duration<double>(steady_clock::now() - startTime).count();
-    cout << "[ALNS] Fin | Mejor costo: " << bestSol.getTotalCost()
-         << " | Iteraciones: " << iteration
-         << " | Tiempo: " << totalTime << "s" << endl;
-
     return bestSol;
 }
 
+/*
+ * Descripción: Define cuántos trabajadores ALNS corren en paralelo en optimize().
+ * Entrada: Número de hilos (1 = secuencial).
+ * Salida: Ninguna.
+ */
+void ALNS::setNumThreads(int threads) {
+    threads = max(1, threads);
+    if (threads == numThreads) return;
+    numThreads = threads;
+    pool.reset();
+    workers.clear();
+}
+
+/*
+ * Descripción: Crea (la primera vez) el pool y un ALNS por trabajador, y les copia la
+ * configuración actual. Cada trabajador tiene su propio CbcSolver, de modo que no comparten
+ * la memoria de subproblemas ni ningún otro estado del solver exacto.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void ALNS::prepareWorkers() {
+    if (!pool) {
+        pool.reset(new ThreadPool(numThreads));
+        for (int w = 0; w < pool->size(); ++w) {
+            CbcSolver* workerCbc = new CbcSolver(parserData);
+            workers.emplace_back(new ALNS(parserData, workerCbc));
+            workers.back()->ownedCbc.reset(workerCbc);
+        }
+    }
+    for (auto& worker : workers) {
+        worker->destroySize = destroySize;
+        worker->vnsIter     = vnsIter;
+        worker->vnsBudgetMs = vnsBudgetMs;
+        worker->heuristicPolishMs = heuristicPolishMs;
+    }
+}
+
+/*
+ * Descripción: Suma las consultas y aciertos de la memoria de subproblemas del CbcSolver
+ * propio y de los de los trabajadores.
+ * Entrada: Referencias donde dejar las consultas y los aciertos.
+ * Salida: Ninguna.
+ */
+void ALNS::cacheStats(long long& lookups, long long& hits) const {
+    lookups = cbcSolver->getCacheLookups();
+    hits    = cbcSolver->getCacheHits();
+    for (const auto& worker : workers) {
+        lookups += worker->cbcSolver->getCacheLookups();
+        hits    += worker->cbcSolver->getCacheHits();
+    }
+}
+
 /*
  * Descripción: Operador de destrucción espacial. Extrae un cliente aleatorio y sus vecinos más cercanos.
  * Entrada: Solución actual, cantidad 'k' de nodos a extraer.
@@ -255,6 +413,166 @@ vector<int> ALNS::randomRemoval(const Solution& sol, int k) {
     return vector<int>(allClients.begin(), allClients.begin() + k);
 }
 
+/*
+ * Descripción: Operador de reparación por inserción. Reinserta los clientes removidos uno a la
+ * vez: con regretK = 1 (greedy) el de inserción más barata; con regretK >= 2 el de mayor
+ * arrepentimiento, es decir, la suma de las diferencias entre su mejor inserción y las
+ * regretK - 1 siguientes en otras rutas. La mejor inserción de cada par (cliente, ruta) se
+ * guarda en caché y sólo se recalcula la columna de la ruta que cambió. Un cliente que no
+ * cabe en ninguna ruta tiene prioridad y abre una ruta nueva.
+ * Entrada: Solución actual, clientes removidos, grado de arrepentimiento, vector donde
+ * registrar el orden de inserción (opcional).
+ * Salida: Solución completa y factible en capacidad.
+ */
+Solution ALNS::regretRepair(const Solution& sol, const vector<int>& removed, int regretK,
+                            vector<int>* insertionOrder) const {
+    int Q = parserData->getCapacity();
+    const auto& clients = parserData->getClients();
+
+    vector<bool> isRemoved(parserData->getDimension() + 1, false);
+    for (int c : removed) isRemoved[c] = true;
+
+    // ── 1. Rutas parciales sin los clientes removidos ────────────────────
+    vector<vector<int>> paths;
+    vector<int>         loads;
+    for (const auto& route : sol.getRoutes()) {
+        vector<int> path;
+        int load = 0;
+        for (int id : route.getPath()) {
+            if (isRemoved[id]) continue;
+            path.push_back(id);
+            if (id != 1) load += clients[id].getDemand();
+        }
+        if (path.size() > 2) {
+            paths.push_back(path);
+            loads.push_back(load);
+        }
+    }
+
+    // ── 2. Caché de inserciones: cache[cliente pendiente][ruta] ──────────
+    vector<int> pending = removed;
+    vector<vector<Insertion>> cache(pending.size());
+    for (size_t c = 0; c < pending.size(); ++c) {
+        for (size_t r = 0; r < paths.size(); ++r) {
+            cache[c].push_back(bestInsertion(pending[c], paths[r], loads[r]));
+        }
+    }
+
+    // ── 3. Insertar de a un cliente ──────────────────────────────────────
+    while (!pending.empty()) {
+        int    chosen      = -1;
+        double chosenScore = 0.0;
+        int    chosenBest  = INT_MAX;
+
+        for (size_t c = 0; c < pending.size(); ++c) {
+            // Abrir una ruta nueva es la alternativa cuando faltan rutas con espacio
+            int newRouteCost = 2 * parserData->getDistance(1, pending[c]);
+
+            vector<int> deltas;
+            for (const auto& ins : cache[c]) {
+                if (ins.delta != INT_MAX) deltas.push_back(ins.delta);
+            }
+            int keep = min((int)deltas.size(), regretK);
+            partial_sort(deltas.begin(), deltas.begin() + keep, deltas.end());
+            deltas.resize(keep);
+
+            double score;
+            int    best;
+            if (deltas.empty()) {
+                score = numeric_limits<double>::infinity();
+                best  = newRouteCost;
+            } else {
+                best = deltas[0];
+                if (regretK == 1) {
+                    score = -best;
+                } else {
+                    score = 0.0;
+                    for (int j = 1; j < regretK; ++j) {
+                        int dj = (j < keep) ? deltas[j] : max(best, newRouteCost);
+                        score += dj - best;
+                    }
+                }
+            }
+
+            if (chosen < 0 || score > chosenScore || (score == chosenScore && best < chosenBest)) {
+                chosen      = c;
+                chosenScore = score;
+                chosenBest  = best;
+            }
+        }
+
+        int client = pending[chosen];
+        if (insertionOrder) insertionOrder->push_back(client);
+        int route  = -1;
+        int pos    = -1;
+        for (size_t r = 0; r < paths.size(); ++r) {
+            const Insertion& ins = cache[chosen][r];
+            if (ins.delta != INT_MAX && (route < 0 || ins.delta < cache[chosen][route].delta)) {
+                route = r;
+                pos   = ins.pos;
+            }
+        }
+        if (route < 0) {
+            paths.push_back({1, 1});
+            loads.push_back(0);
+            route = paths.size() - 1;
+            pos   = 1;
+            for (auto& row : cache) row.push_back({INT_MAX, -1});
+        }
+
+        paths[route].insert(paths[route].begin() + pos, client);
+        loads[route] += clients[client].getDemand();
+
+        pending.erase(pending.begin() + chosen);
+        cache.erase(cache.begin() + chosen);
+        for (size_t c = 0; c < pending.size(); ++c) {
+            cache[c][route] = bestInsertion(pending[c], paths[route], loads[route]);
+        }
+    }
+
+    Solution result(parserData);
+    for (const auto& path : paths) {
+        result.addRoute(Route(Q, parserData, path));
+    }
+    return result;
+}
+
+/*
+ * Descripción: Busca la posición más barata para insertar un cliente en una ruta.
+ * Entrada: ID del cliente, camino de la ruta (con la bodega en ambos extremos), carga actual.
+ * Salida: Variación del costo y posición; delta = INT_MAX si el cliente no cabe.
+ */
+ALNS::Insertion ALNS::bestInsertion(int clientId, const vector<int>& path, int load) const {
+    Insertion best = {INT_MAX, -1};
+    if (load + parserData->getClients()[clientId].getDemand() > parserData->getCapacity()) return best;
+
+    for (size_t p = 1; p < path.size(); ++p) {
+        int delta = (int)insertionCost(clientId, path[p-1], path[p]);
+        if (delta < best.delta) {
+            best.delta = delta;
+            best.pos   = p;
+        }
+    }
+    return best;
+}
+
+/*
+ * Descripción: Selección por ruleta proporcional a los pesos adaptativos.
+ * Entrada: Pesos de los operadores.
+ * Salida: Índice del operador elegido.
+ */
+int ALNS::selectOperator(const vector<double>& weights) {
+    double totalWeight = 0.0;
+    for (double w : weights) totalWeight += w;
+    double r = uniform_real_distribution<double>(0.0, totalWeight)(rng);
+
+    for (size_t i = 0; i + 1 < weights.size(); ++i) {
+        if (r < weights[i]) return i;
+        r -= weights[i];
+    }
+    return weights.size() - 1;
+}
+
 /*
  * Descripción: Evalúa la variación en la función objetivo al insertar un nodo entre otros dos.
  * Entrada: ID del cliente a evaluar, ID del cliente previo, ID del cliente siguiente.
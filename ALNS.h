@@ -3,43 +3,110 @@
 
 #include <vector>
 #include <random>
+#include <memory>
+#include <mutex>
+#include <chrono>
 #include "Parser.h"
 #include "Solution.h"
 #include "Route.h"
 #include "VNS.h"
+#include "ThreadPool.h"
 
 class CbcSolver;
 
 /*
  * Clase ALNS
  * Descripción: Implementa la metaheurística Adaptive Large Neighborhood Search.
- * Coordina la destrucción de componentes de la solución y delega la reparación 
- * óptima de dichos subproblemas al solver exacto CBC.
+ * Coordina la destrucción de componentes de la solución y su reparación, que se elige
+ * adaptativamente entre el subproblema óptimo del solver exacto CBC y las inserciones
+ * greedy, regret-2 y regret-3, mucho más baratas. Con varios hilos, cada trabajador
+ * destruye, repara y pule su propia copia con una semilla distinta; las mejoras se publican
+ * en un incumbente compartido y los pesos de los operadores se promedian periódicamente.
  */
 class ALNS {
 public:
     ALNS(const Parser* parser, CbcSolver* cbc);
+    ~ALNS();
 
     Solution optimize(const Solution& initialSol, double timeLimitSeconds);
 
     void setDestroySize(int k) { destroySize = k; }
     void setVnsIterations(int iter) { vnsIter = iter; }
+    void setVnsTimeBudget(int milliseconds) { vnsBudgetMs = milliseconds; }
+    void setHeuristicPolishBudget(int milliseconds) { heuristicPolishMs = milliseconds; }
+    void setNumThreads(int threads);
+
+    // Reparación por inserción (regretK = 1: greedy). Si se entrega 'insertionOrder', recibe
+    // los clientes en el orden en que fueron insertados.
+    Solution regretRepair(const Solution& sol, const std::vector<int>& removed, int regretK,
+                          std::vector<int>* insertionOrder = nullptr) const;
 
 private:
+    typedef std::chrono::steady_clock Clock;
+
+    // Operadores de reparación. Los heurísticos valen su grado de arrepentimiento (1 = greedy).
+    enum RepairOperator { CbcRepair, GreedyRepair, Regret2Repair, Regret3Repair, NUM_REPAIRS };
+
+    /*
+     * Estructura SharedSearch
+     * Descripción: Estado común a los trabajadores del modo paralelo: incumbente, pesos
+     * de los operadores destroy y repair, e iteraciones acumuladas. Todo se accede bajo 'mtx'.
+     */
+    struct SharedSearch {
+        std::mutex          mtx;
+        Solution            best;
+        std::vector<double> weights;
+        std::vector<double> repairWeights;
+        long long           iterations = 0;
+
+        explicit SharedSearch(const Solution& initial)
+            : best(initial), weights(3, 1.0), repairWeights(NUM_REPAIRS, 1.0) {}
+    };
+
+    /*
+     * Estructura Insertion
+     * Descripción: Mejor inserción de un cliente en una ruta (delta = INT_MAX si no cabe).
+     */
+    struct Insertion {
+        int delta;
+        int pos;
+    };
+
     const Parser* parserData;
     CbcSolver* cbcSolver;
+    std::unique_ptr<CbcSolver> ownedCbc;   // sólo en los trabajadores: su propio solver exacto
     VNS           vns;
 
     int destroySize = 15;
     int vnsIter     = 10;
+    int vnsBudgetMs = 500;   // tope de tiempo de cada pulido VNS
+    int heuristicPolishMs = 50;  // tope del pulido tras una reparación heurística (0 = sin pulido)
 
     std::mt19937 rng;
 
+    static constexpr unsigned int SEED          = 42;
+    static constexpr int          SYNC_INTERVAL = 20;   // iteraciones entre actualizaciones de pesos
+
+    // ── Modo paralelo ─────────────────────────────────────────
+    int                                numThreads = 1;
+    std::unique_ptr<ThreadPool>        pool;
+    std::vector<std::unique_ptr<ALNS>> workers;      // cada uno con su CbcSolver y su memoria de subproblemas
+
+    void prepareWorkers();
+    void cacheStats(long long& lookups, long long& hits) const;
+    Solution search(const Solution& initialSol, Clock::time_point startTime,
+                    double timeLimitSeconds, SharedSearch* shared, long long& iteration);
+
     // ── Operadores Destroy ────────────────────────────────────
     std::vector<int> shawRemoval(const Solution& sol, int k);
     std::vector<int> worstRemoval(const Solution& sol, int k);
     std::vector<int> randomRemoval(const Solution& sol, int k);
 
+    // ── Operadores Repair heurísticos ─────────────────────────
+    Insertion bestInsertion(int clientId, const std::vector<int>& path, int load) const;
+
+    int selectOperator(const std::vector<double>& weights);
+
     // ── Helpers ───────────────────────────────────────────────
     double insertionCost(int clientId, int prev, int next) const;
     double removalSavings(int clientId, int prev, int next) const;
@@ -12,7 +12,7 @@ using namespace std;
  * Salida: Instancia inicializada.
  */
 BranchAndBound::BranchAndBound(const Parser* parser, const Solution& initialSolution) 
-    : parserData(parser), bestSolution(initialSolution) {
+    : parserData(parser), bestSolution(initialSolution), kopt(parser) {
     globalUpperBound = initialSolution.getTotalCost();
     numClients = parserData->getDimension(); 
     numVariables = numClients * numClients; 
@@ -405,7 +405,6 @@ Solution BranchAndBound::solveBestFirst(double timeLimitSeconds) {
         
         Solution roundedSol = lpGuidedConstruction(solution);
         if (roundedSol.isValid()) {
-            KOpt kopt(parserData);
             Solution koptSol = kopt.optimize(roundedSol);
     
             if (koptSol.getTotalCost() < globalUpperBound) {
@@ -541,7 +540,6 @@ Solution BranchAndBound::solveDepthFirst(double timeLimitSeconds) {
         
         Solution roundedSol = lpGuidedConstruction(solution);
         if (roundedSol.isValid()) {
-            KOpt kopt(parserData);
             Solution koptSol = kopt.optimize(roundedSol);
     
             if (koptSol.getTotalCost() < globalUpperBound) {
@@ -31,6 +31,7 @@ private:
     const Parser* parserData;
     double globalUpperBound;             
     Solution bestSolution;               
+    KOpt kopt;                           
     
     int numClients;                      
     int numVariables;                    
@@ -48,6 +49,13 @@ public:
     BranchAndBound(const Parser* parser, const Solution& initialSolution);
     Solution solveBestFirst(double timeLimitSeconds = 120.0);
     Solution solveDepthFirst(double timeLimitSeconds = 120.0);
+
+    // La heurística primal usa por defecto el 3-OPT exhaustivo; OrThreeOpt con
+    // FirstImprovement abarata cada nodo a cambio de cotas superiores distintas
+    void setIntraRouteMode(KOpt::Mode mode, KOpt::Policy policy = KOpt::Policy::FirstImprovement) {
+        kopt.setMode(mode);
+        kopt.setPolicy(policy);
+    }
     ~BranchAndBound();
 };
 
@@ -1,6 +1,5 @@
 #include "CbcSolver.h"
 #include <iostream>
-#include <unistd.h>
 #include <coin/OsiClpSolverInterface.hpp>
 #include <coin/CbcModel.hpp>
 #include <coin/CoinPackedMatrix.hpp>
@@ -10,6 +9,8 @@
 #include <coin/CbcHeuristicFPump.hpp>
 #include <coin/CbcHeuristicRINS.hpp>
 #include <climits>
+#include <thread>
+#include <mutex>
 
 using namespace std;
 
@@ -200,11 +201,15 @@ Solution CbcSolver::solve(const Solution& warmStart, double timeLimitSeconds) {
     // =========================================================
     CbcModel model(osi);
     model.setLogLevel(0);
+    model.solver()->messageHandler()->setLogLevel(0);
 
     // =========================================================
     // 6. Warm Start
     // =========================================================
+    // El heurístico de CBC pule una sola trayectoria: los hilos disponibles se usan para
+    // repartir la evaluación de cada paso del VND y así acortar su latencia
     VNS vns(parserData);
+    vns.setEvaluationThreads(std::thread::hardware_concurrency());
 
     double* mipStart = new double[numVariables];
     std::fill(mipStart, mipStart + numVariables, 0.0);
@@ -276,17 +281,8 @@ Solution CbcSolver::solve(const Solution& warmStart, double timeLimitSeconds) {
          << " | Warm start: " << warmStart.getTotalCost()
          << " | Limite: " << timeLimitSeconds << "s ===" << endl;
 
-    // Suprimir stdout interno de CBC/CGL para mantener limpia la consola
-    int savedStdout = dup(STDOUT_FILENO);
-    freopen("/dev/null", "w", stdout);
-
     model.branchAndBound();
 
-    fflush(stdout);
-    dup2(savedStdout, STDOUT_FILENO);
-    close(savedStdout);
-    std::cout.clear();
-
     // =========================================================
     // 10. Extraer y refinar la mejor solución encontrada
     // =========================================================
@@ -328,6 +324,9 @@ Solution CbcSolver::solve(const Solution& warmStart, double timeLimitSeconds) {
 /*
  * Descripción: Núcleo del LNS-MIP. Recibe la solución actual y los clientes liberados
  * por el operador destroy de ALNS, construye un mini-CVRP y lo resuelve óptimamente.
+ * Cada llamada arma su propio modelo, por lo que varios hilos pueden invocarla a la vez.
+ * El resultado se memoriza por (clientes liberados, flota del mini-modelo); un acierto se
+ * reutiliza si era óptimo probado o si ahora no se daría más tiempo que la vez anterior.
  * Entrada: Solución base actual, vector de clientes extraídos, tiempo límite.
  * Salida: Solución completa fusionando stubs intactos con nuevas mini-rutas.
  */
@@ -370,6 +369,22 @@ Solution CbcSolver::solveSubproblem(const Solution&         currentSol,
     }
 
     int numAffected = (int)stubs.size();
+    int maxMiniVehicles = numAffected + 1;
+
+    // ── 1b. Consultar la memoria de subproblemas ─────────────────────────
+    // Las cargas residuales de los stubs no entran al mini-modelo (sólo a la fusión, que se
+    // rehace siempre), así que bastan el conjunto liberado y la cota de vehículos.
+    SubproblemKey key(vector<int>(freeSet.begin(), freeSet.end()), maxMiniVehicles);
+    {
+        lock_guard<mutex> lock(cacheMutex);
+        cacheLookups++;
+        auto it = subproblemCache.find(key);
+        if (it != subproblemCache.end() &&
+            (it->second.provenOptimal || timeLimitSeconds <= it->second.timeLimit)) {
+            cacheHits++;
+            return mergeSubproblemResult(fixedRoutes, stubs, stubLoads, it->second.miniRoutes);
+        }
+    }
 
     // ── 2. Construir mini-CVRP ────────────────────────────────────────────
     int miniN        = k + 1;
@@ -422,7 +437,6 @@ Solution CbcSolver::solveSubproblem(const Solution&         currentSol,
     }
 
     // B. Flota
-    int maxMiniVehicles = numAffected + 1;
     {
         vector<int> dO, dI; vector<double> dOe, dIe;
         for (int j = 1; j < miniN; ++j) {
@@ -471,20 +485,15 @@ Solution CbcSolver::solveSubproblem(const Solution&         currentSol,
         }
     }
 
+    // Los mensajes de CBC y del CLP interno se silencian en sus manejadores (estado propio del
+    // modelo), sin redirigir stdout, que es global al proceso
     CbcModel miniModel(miniOsi);
     miniModel.setLogLevel(0);
+    miniModel.solver()->messageHandler()->setLogLevel(0);
     miniModel.setMaximumSeconds(timeLimitSeconds);
 
-    int savedFd = dup(STDOUT_FILENO);
-    freopen("/dev/null", "w", stdout);
-
     miniModel.branchAndBound();
 
-    fflush(stdout);
-    dup2(savedFd, STDOUT_FILENO);
-    close(savedFd);
-    std::cout.clear();
-
     // ── 5. Reconstruir si CBC encontró solución ───────────────────────────
     if (!miniModel.bestSolution() || miniModel.getObjValue() >= 1e49) {
         delete[] mObj; delete[] mLb; delete[] mUb;
@@ -515,9 +524,27 @@ Solution CbcSolver::solveSubproblem(const Solution&         currentSol,
 
     delete[] mObj; delete[] mLb; delete[] mUb;
 
+    {
+        lock_guard<mutex> lock(cacheMutex);
+        if (subproblemCache.size() >= MAX_CACHE_ENTRIES) subproblemCache.clear();
+        subproblemCache[key] = {miniRoutes, miniModel.isProvenOptimal(), timeLimitSeconds};
+    }
+
     return mergeSubproblemResult(fixedRoutes, stubs, stubLoads, miniRoutes);
 }
 
+/*
+ * Descripción: Vacía la memoria de subproblemas y reinicia sus estadísticas.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void CbcSolver::clearSubproblemCache() {
+    lock_guard<mutex> lock(cacheMutex);
+    subproblemCache.clear();
+    cacheLookups = 0;
+    cacheHits    = 0;
+}
+
 /*
  * Descripción: Estrategia de fusión espacial (Greedy-Distance). Inserta las 
  * mini-rutas calculadas por CBC en la posición geométrica más económica dentro de los stubs.
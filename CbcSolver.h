@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <chrono>
+#include <map>
+#include <mutex>
 #include "Parser.h"
 #include "Solution.h"
 #include "Route.h"
@@ -20,8 +22,10 @@
  */
 class CbcProgressHandler : public CbcEventHandler {
 public:
-    CbcProgressHandler(const Parser* parser, VNS* vns)
-        : parserData(parser), vnsPtr(vns), lastReportNodes(0) {}
+    // El pulido VNS de cada solución entera se acota a 'vnsBudgetMs' milisegundos para no
+    // detener el Branch & Cut
+    CbcProgressHandler(const Parser* parser, VNS* vns, int vnsBudgetMs = DEFAULT_VNS_BUDGET_MS)
+        : parserData(parser), vnsPtr(vns), lastReportNodes(0), vnsBudget(vnsBudgetMs) {}
 
     CbcAction event(CbcEvent whichEvent) override {
         if (!model_) return noAction;
@@ -47,7 +51,9 @@ public:
             Solution cbcSol = convertToSolution(model_->bestSolution());
             
             if (cbcSol.isValid()) {
-                Solution refined = vnsPtr->optimize(cbcSol, 20);
+                VNS::StopCriteria stop;
+                stop.deadline = VNS::Clock::now() + std::chrono::milliseconds(vnsBudget);
+                Solution refined = vnsPtr->optimize(cbcSol, 20, stop);
                 
                 if (refined.getTotalCost() < costBefore - 0.5) {
                     std::cerr << "[CBC+VNS] Solucion " << (int)costBefore
@@ -82,6 +88,9 @@ private:
     const Parser* parserData;
     VNS* vnsPtr;
     int           lastReportNodes;
+    int           vnsBudget;
+
+    static constexpr int DEFAULT_VNS_BUDGET_MS = 100;
 
     /*
      * Descripción: Convierte el arreglo LP unidimensional a un objeto Solution.
@@ -116,13 +125,36 @@ private:
  * Clase CbcSolver
  * Descripción: Wrapper para el solver MIP de COIN-OR (CBC). Proporciona métodos 
  * para resolver el problema completo o subproblemas locales delegados por metaheurísticas.
+ * Los mini-CVRP ya resueltos se memorizan: si ALNS vuelve a liberar el mismo conjunto de
+ * clientes con la misma flota disponible, se reutilizan sus mini-rutas sin llamar a CBC.
  */
 class CbcSolver {
 private:
+    /*
+     * Estructura SubproblemEntry
+     * Descripción: Resultado memorizado de un mini-CVRP: sus mini-rutas (IDs reales), si CBC
+     * probó su optimalidad y el tiempo límite con que se obtuvo.
+     */
+    struct SubproblemEntry {
+        std::vector<std::vector<int>> miniRoutes;
+        bool                          provenOptimal;
+        double                        timeLimit;
+    };
+
+    // Clave: clientes liberados ordenados y máximo de vehículos del mini-modelo
+    typedef std::pair<std::vector<int>, int> SubproblemKey;
+
     const Parser* parserData;
     int numClients;
     int numVariables;
 
+    std::map<SubproblemKey, SubproblemEntry> subproblemCache;
+    mutable std::mutex                       cacheMutex;
+    long long                                cacheLookups = 0;
+    long long                                cacheHits    = 0;
+
+    static constexpr size_t MAX_CACHE_ENTRIES = 50000;   // al llenarse se vacía completo
+
     int getVarIndex(int i, int j) const;
     int getUIndex(int i) const;
     Solution convertToSolution(const double* solution) const;
@@ -141,6 +173,10 @@ public:
     Solution solveSubproblem(const Solution&          currentSol,
                              const std::vector<int>&  freeClients,
                              double                   timeLimitSeconds = 1.0);
+
+    long long getCacheLookups() const { std::lock_guard<std::mutex> lock(cacheMutex); return cacheLookups; }
+    long long getCacheHits() const { std::lock_guard<std::mutex> lock(cacheMutex); return cacheHits; }
+    void clearSubproblemCache();
 };
 
 #endif // CBC_SOLVER_H
\ No newline at end of file
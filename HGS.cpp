@@ -0,0 +1,464 @@
+#include "HGS.h"
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+using namespace std;
+using chrono::duration;
+
+/*
+ * Descripción: Constructor de la metaheurística HGS. La educación usa VNS granular con
+ * capacidad penalizada, de la que toma la penalización inicial, y todas las vecindades
+ * inter-ruta (incluidas 2-OPT*, CROSS, SWAP* y las cadenas de expulsión).
+ * Entrada: Puntero constante al parser con los datos de la instancia.
+ * Salida: Instancia inicializada.
+ */
+HGS::HGS(const Parser* parser) : parserData(parser), vns(parser), rng(42) {
+    vns.setGranularity(20);
+    vns.setNeighborhoodOrder({ VNS::Relocate, VNS::Swap, VNS::OrOpt2, VNS::OrOpt3, VNS::TwoOptStar,
+                               VNS::CrossExchange, VNS::SwapStar, VNS::EjectionChain });
+    vns.setPenalizedCapacity(true);
+    penaltyCapacity = vns.getCapacityPenalty();
+}
+
+// ─────────────────────────────────────────────────────────────
+// Representación: tour gigante, cruce y Split
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Genera una permutación aleatoria de todos los clientes.
+ * Entrada: Ninguna.
+ * Salida: Tour gigante.
+ */
+vector<int> HGS::randomGiantTour() {
+    vector<int> tour(parserData->getDimension() - 1);
+    iota(tour.begin(), tour.end(), 2);
+    shuffle(tour.begin(), tour.end(), rng);
+    return tour;
+}
+
+/*
+ * Descripción: Concatena las rutas de una solución en un tour gigante, ordenándolas por el
+ * ángulo polar de su baricentro para que rutas vecinas queden contiguas en el cruce.
+ * Entrada: Solución.
+ * Salida: Tour gigante.
+ */
+vector<int> HGS::extractGiantTour(const Solution& sol) const {
+    const auto& clients = parserData->getClients();
+    const auto& routes  = sol.getRoutes();
+
+    vector<pair<double, int>> order;
+    for (int r = 0; r < (int)routes.size(); r++) {
+        const vector<int>& path = routes[r].getPath();
+        if (path.size() <= 2) continue;
+        double x = 0.0, y = 0.0;
+        for (int i = 1; i < (int)path.size() - 1; i++) {
+            x += clients[path[i]].getX();
+            y += clients[path[i]].getY();
+        }
+        int size = path.size() - 2;
+        order.push_back({ atan2(y / size - clients[1].getY(), x / size - clients[1].getX()), r });
+    }
+    sort(order.begin(), order.end());
+
+    vector<int> tour;
+    for (const auto& [angle, r] : order) {
+        const vector<int>& path = routes[r].getPath();
+        tour.insert(tour.end(), path.begin() + 1, path.end() - 1);
+    }
+    return tour;
+}
+
+/*
+ * Descripción: Cruce de orden (OX): copia un segmento circular del primer padre en las
+ * mismas posiciones y completa con los clientes restantes en el orden del segundo padre,
+ * empezando tras el segmento. El segmento tiene entre 1 y n - 1 clientes, de modo que el
+ * hijo siempre recibe material de ambos padres.
+ * Entrada: Tours gigantes de ambos padres.
+ * Salida: Tour gigante del hijo.
+ */
+vector<int> HGS::crossoverOX(const vector<int>& parent1, const vector<int>& parent2) {
+    int n = parent1.size();
+    vector<int>  child(n);
+    vector<char> used(parserData->getDimension() + 1, 0);
+
+    uniform_int_distribution<int> pickStart(0, n - 1);
+    uniform_int_distribution<int> pickLength(1, max(1, n - 1));
+    int start  = pickStart(rng);
+    int length = pickLength(rng);
+    int end    = (start + length - 1) % n;
+
+    int j = start;
+    for (int k = 0; k < length; k++, j++) {
+        child[j % n] = parent1[j % n];
+        used[child[j % n]] = 1;
+    }
+    for (int i = 1; i <= n; i++) {
+        int client = parent2[(end + i) % n];
+        if (used[client]) continue;
+        child[j % n] = client;
+        j++;
+    }
+    return child;
+}
+
+/*
+ * Descripción: Split: corta el tour gigante en rutas de forma óptima (camino más corto en el
+ * DAG de cortes) con flota ilimitada. Admite rutas sobrecargadas hasta MAX_LOAD_FACTOR * Q,
+ * cuyo exceso se cobra con la penalización vigente.
+ * Entrada: Tour gigante.
+ * Salida: Solución (posiblemente infactible en capacidad).
+ */
+Solution HGS::split(const vector<int>& giantTour) const {
+    const auto& clients = parserData->getClients();
+    int n = giantTour.size();
+    int Q = parserData->getCapacity();
+
+    vector<double> potential(n + 1, numeric_limits<double>::infinity());
+    vector<int>    pred(n + 1, -1);
+    potential[0] = 0.0;
+
+    for (int i = 0; i < n; i++) {
+        int    load = 0;
+        double dist = 0.0;
+        for (int j = i; j < n; j++) {
+            load += clients[giantTour[j]].getDemand();
+            dist += (j == i) ? parserData->getDistance(1, giantTour[j])
+                             : parserData->getDistance(giantTour[j - 1], giantTour[j]);
+            if (j > i && load > MAX_LOAD_FACTOR * Q) break;
+
+            double cost = potential[i] + dist + parserData->getDistance(giantTour[j], 1)
+                        + penaltyCapacity * max(0, load - Q);
+            if (cost < potential[j + 1]) {
+                potential[j + 1] = cost;
+                pred[j + 1]      = i;
+            }
+        }
+    }
+
+    Solution sol(parserData);
+    for (int end = n; end > 0; end = pred[end]) {
+        vector<int> path = { 1 };
+        path.insert(path.end(), giantTour.begin() + pred[end], giantTour.begin() + end);
+        path.push_back(1);
+        sol.addRoute(Route(Q, parserData, path));
+    }
+    return sol;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Ciclo de vida de los individuos
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Construye un individuo a partir de una solución educada.
+ * Entrada: Solución.
+ * Salida: Individuo con tour gigante, adyacencias y costo penalizado.
+ */
+unique_ptr<HGS::Individual> HGS::makeIndividual(const Solution& sol) const {
+    unique_ptr<Individual> indiv(new Individual());
+    indiv->solution  = sol;
+    indiv->giantTour = extractGiantTour(sol);
+    indiv->successor.assign(parserData->getDimension() + 1, 1);
+    indiv->predecessor.assign(parserData->getDimension() + 1, 1);
+    for (const auto& route : sol.getRoutes()) {
+        const vector<int>& path = route.getPath();
+        for (int i = 1; i < (int)path.size() - 1; i++) {
+            indiv->predecessor[path[i]] = path[i - 1];
+            indiv->successor[path[i]]   = path[i + 1];
+        }
+    }
+    indiv->distance      = sol.getTotalCost();
+    indiv->excess        = vns.totalExcess(sol);
+    indiv->penalizedCost = indiv->distance + penaltyCapacity * indiv->excess;
+    return indiv;
+}
+
+/*
+ * Descripción: Educación del hijo: optimización intra-ruta y VND con todas las vecindades
+ * de VNS (sin fase de agitación) sobre el costo penalizado con la penalización vigente, de
+ * modo que el hijo puede quedar infactible.
+ * Entrada: Solución (se modifica), plazo global.
+ * Salida: Ninguna.
+ */
+void HGS::educate(Solution& sol, Clock::time_point deadline) {
+    VNS::StopCriteria stop;
+    stop.deadline = deadline;
+    vns.setCapacityPenalty(penaltyCapacity);
+    vns.localSearch(sol, stop);
+}
+
+/*
+ * Descripción: Reparación de un hijo infactible: fase de reparación de VNS (VND con la
+ * penalización multiplicada hasta respetar la capacidad).
+ * Entrada: Solución educada (se modifica), plazo global.
+ * Salida: Booleano indicando si la solución quedó factible.
+ */
+bool HGS::repair(Solution& sol, Clock::time_point deadline) {
+    VNS::StopCriteria stop;
+    stop.deadline = deadline;
+    vns.setCapacityPenalty(penaltyCapacity);
+    return vns.repairCapacity(sol, stop);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Gestión de la población
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Distancia de pares rotos: fracción de clientes cuyas adyacencias difieren
+ * entre dos soluciones (ignorando el sentido de las rutas).
+ * Entrada: Dos individuos.
+ * Salida: Distancia en [0, 1].
+ */
+double HGS::brokenPairsDistance(const Individual& a, const Individual& b) const {
+    int differences = 0;
+    int dimension   = parserData->getDimension();
+    for (int j = 2; j <= dimension; j++) {
+        if (a.successor[j] != b.successor[j] && a.successor[j] != b.predecessor[j]) differences++;
+        if (a.predecessor[j] == 1 && b.predecessor[j] != 1 && b.successor[j] != 1) differences++;
+    }
+    return (double)differences / (dimension - 1);
+}
+
+/*
+ * Descripción: Distancia de pares rotos entre dos soluciones (construye sus individuos).
+ * Entrada: Dos soluciones.
+ * Salida: Distancia en [0, 1].
+ */
+double HGS::brokenPairsDistance(const Solution& a, const Solution& b) const {
+    return brokenPairsDistance(*makeIndividual(a), *makeIndividual(b));
+}
+
+/*
+ * Descripción: Calcula la aptitud sesgada de cada individuo: rango por costo penalizado más
+ * rango por diversidad (distancia media a sus NB_CLOSE más cercanos), ponderado para que
+ * los NB_ELITE mejores sobrevivan. Menor es mejor.
+ * Entrada: Subpoblación.
+ * Salida: Ninguna (actualiza biasedFitness).
+ */
+void HGS::updateBiasedFitness(SubPopulation& pop) const {
+    int size = pop.size();
+    if (size == 1) pop[0]->biasedFitness = 0.0;
+    if (size <= 1) return;
+
+    vector<int> byCost(size), byDiversity(size);
+    vector<double> diversity(size, 0.0);
+    iota(byCost.begin(), byCost.end(), 0);
+    iota(byDiversity.begin(), byDiversity.end(), 0);
+
+    for (int i = 0; i < size; i++) {
+        int counted = 0;
+        for (const auto& [dist, other] : pop[i]->proximity) {
+            if (counted == NB_CLOSE) break;
+            diversity[i] += dist;
+            counted++;
+        }
+        diversity[i] /= max(1, counted);
+    }
+
+    stable_sort(byCost.begin(), byCost.end(),
+                [&](int a, int b) { return pop[a]->penalizedCost < pop[b]->penalizedCost; });
+    stable_sort(byDiversity.begin(), byDiversity.end(),
+                [&](int a, int b) { return diversity[a] > diversity[b]; });
+
+    vector<double> costRank(size), diversityRank(size);
+    for (int k = 0; k < size; k++) {
+        costRank[byCost[k]]           = (double)k / (size - 1);
+        diversityRank[byDiversity[k]] = (double)k / (size - 1);
+    }
+
+    double diversityWeight = size > NB_ELITE ? 1.0 - (double)NB_ELITE / size : 0.0;
+    for (int i = 0; i < size; i++)
+        pop[i]->biasedFitness = costRank[i] + diversityWeight * diversityRank[i];
+}
+
+/*
+ * Descripción: Elimina el peor individuo de una subpoblación según la aptitud sesgada,
+ * eliminando primero los clones (distancia cero a otro individuo).
+ * Entrada: Subpoblación.
+ * Salida: Ninguna.
+ */
+void HGS::removeWorst(SubPopulation& pop) {
+    updateBiasedFitness(pop);
+
+    int  worst      = -1;
+    bool worstClone = false;
+    for (int i = 0; i < (int)pop.size(); i++) {
+        bool clone = !pop[i]->proximity.empty() && pop[i]->proximity.begin()->first < 1e-9;
+        if (worst == -1 || (clone && !worstClone) ||
+            (clone == worstClone && pop[i]->biasedFitness > pop[worst]->biasedFitness)) {
+            worst      = i;
+            worstClone = clone;
+        }
+    }
+
+    Individual* removed = pop[worst].get();
+    for (auto& other : pop) {
+        if (other.get() == removed) continue;
+        for (auto it = other->proximity.begin(); it != other->proximity.end(); ++it) {
+            if (it->second == removed) { other->proximity.erase(it); break; }
+        }
+    }
+    pop.erase(pop.begin() + worst);
+}
+
+/*
+ * Descripción: Inserta un individuo en la subpoblación que corresponda según su factibilidad;
+ * si la subpoblación supera mu + lambda, selecciona sobrevivientes hasta dejar mu.
+ * Entrada: Individuo, mejor solución factible (se actualiza).
+ * Salida: Booleano indicando si el individuo mejoró la mejor solución factible.
+ */
+bool HGS::addIndividual(unique_ptr<Individual> indiv, Solution& bestSol) {
+    bool feasible = indiv->excess == 0;
+    SubPopulation& pop = feasible ? feasiblePop : infeasiblePop;
+
+    bool improved = feasible && (bestSol.getRoutes().empty() ||
+                                 indiv->distance < bestSol.getTotalCost() - 1e-6);
+    if (improved) bestSol = indiv->solution;
+
+    for (auto& other : pop) {
+        double dist = brokenPairsDistance(*indiv, *other);
+        indiv->proximity.insert({ dist, other.get() });
+        other->proximity.insert({ dist, indiv.get() });
+    }
+    pop.push_back(move(indiv));
+
+    if ((int)pop.size() > mu + lambda) {
+        while ((int)pop.size() > mu) removeWorst(pop);
+    }
+    updateBiasedFitness(pop);
+    return improved;
+}
+
+/*
+ * Descripción: Selección de un padre por torneo binario sobre ambas subpoblaciones.
+ * Entrada: Ninguna.
+ * Salida: Referencia al individuo ganador.
+ */
+const HGS::Individual& HGS::binaryTournament() {
+    int total = feasiblePop.size() + infeasiblePop.size();
+    uniform_int_distribution<int> pick(0, total - 1);
+
+    auto at = [&](int k) -> const Individual& {
+        return k < (int)feasiblePop.size() ? *feasiblePop[k] : *infeasiblePop[k - feasiblePop.size()];
+    };
+    const Individual& a = at(pick(rng));
+    const Individual& b = at(pick(rng));
+    return a.biasedFitness <= b.biasedFitness ? a : b;
+}
+
+/*
+ * Descripción: Ajusta la penalización de capacidad para acercar la fracción de hijos
+ * factibles a TARGET_FEASIBLE y recalcula los costos de la subpoblación infactible.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void HGS::managePenalty() {
+    double fraction = (double)count(recentFeasible.begin(), recentFeasible.end(), 1) / recentFeasible.size();
+    recentFeasible.clear();
+
+    if (fraction < TARGET_FEASIBLE - 0.05)      penaltyCapacity = min(100000.0, penaltyCapacity * 1.2);
+    else if (fraction > TARGET_FEASIBLE + 0.05) penaltyCapacity = max(0.1, penaltyCapacity * 0.85);
+
+    for (auto& indiv : infeasiblePop)
+        indiv->penalizedCost = indiv->distance + penaltyCapacity * indiv->excess;
+    updateBiasedFitness(infeasiblePop);
+}
+
+/*
+ * Descripción: Construye la población inicial: la solución de entrada y tours gigantes
+ * aleatorios (Split + educación), hasta 4 * mu individuos o el 20% del tiempo disponible.
+ * Entrada: Solución inicial, mejor solución (se actualiza), plazo global.
+ * Salida: Ninguna.
+ */
+void HGS::initializePopulation(const Solution& initialSol, Solution& bestSol, Clock::time_point deadline) {
+    Clock::time_point start = Clock::now();
+    Clock::time_point initDeadline = start + (deadline - start) / 5;
+
+    Solution seed = initialSol;
+    educate(seed, deadline);
+    addIndividual(makeIndividual(seed), bestSol);
+
+    for (int k = 1; k < 4 * mu && Clock::now() < initDeadline; k++) {
+        Solution sol = split(randomGiantTour());
+        educate(sol, deadline);
+        addIndividual(makeIndividual(sol), bestSol);
+
+        if (vns.totalExcess(sol) > 0 && uniform_real_distribution<double>(0.0, 1.0)(rng) < REPAIR_PROBABILITY &&
+            repair(sol, deadline)) {
+            addIndividual(makeIndividual(sol), bestSol);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────
+// Ciclo Principal
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Bucle principal de HGS: selección de padres, cruce OX, Split, educación,
+ * reparación probabilística de hijos infactibles, gestión de la penalización y reinicio de
+ * la población tras ITER_NO_IMPROVE iteraciones sin mejora.
+ * Entrada: Solución factible inicial, límite de tiempo de ejecución en segundos.
+ * Salida: La mejor solución factible encontrada.
+ */
+Solution HGS::optimize(const Solution& initialSol, double timeLimitSeconds) {
+    Clock::time_point startTime = Clock::now();
+    Clock::time_point deadline  = startTime + chrono::duration_cast<Clock::duration>(
+                                                  duration<double>(timeLimitSeconds));
+
+    Solution bestSol = initialSol.isValid() ? initialSol : Solution(parserData);
+    feasiblePop.clear();
+    infeasiblePop.clear();
+    recentFeasible.clear();
+
+    cout << "[HGS] Inicio | Costo: " << initialSol.getTotalCost()
+         << " | mu=" << mu << " lambda=" << lambda << endl;
+
+    initializePopulation(initialSol, bestSol, deadline);
+
+    int iteration      = 0;
+    int noImprovement  = 0;
+    while (Clock::now() < deadline) {
+        iteration++;
+
+        vector<int> childTour = crossoverOX(binaryTournament().giantTour, binaryTournament().giantTour);
+        Solution child = split(childTour);
+        educate(child, deadline);
+
+        bool feasible = vns.totalExcess(child) == 0;
+        recentFeasible.push_back(feasible);
+        bool improved = addIndividual(makeIndividual(child), bestSol);
+
+        if (!feasible && uniform_real_distribution<double>(0.0, 1.0)(rng) < REPAIR_PROBABILITY &&
+            repair(child, deadline)) {
+            improved = addIndividual(makeIndividual(child), bestSol) || improved;
+        }
+
+        if (improved) {
+            noImprovement = 0;
+            double elapsed = duration<double>(Clock::now() - startTime).count();
+            cout << "EN " << elapsed << "s" "   ---> [HGS NUEVO OPTIMO GLOBAL]: " << bestSol.getTotalCost() << "\n";
+        } else {
+            noImprovement++;
+        }
+
+        if ((int)recentFeasible.size() == PENALTY_WINDOW) managePenalty();
+
+        if (noImprovement == ITER_NO_IMPROVE) {
+            feasiblePop.clear();
+            infeasiblePop.clear();
+            initializePopulation(bestSol, bestSol, deadline);
+            noImprovement = 0;
+        }
+    }
+
+    cout << "[HGS] Fin | Iteraciones: " << iteration
+         << " | Mejor costo: " << bestSol.getTotalCost()
+         << " | Penalizacion final: " << penaltyCapacity << endl;
+
+    return bestSol.getRoutes().empty() ? initialSol : bestSol;
+}
\ No newline at end of file
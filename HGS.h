@@ -0,0 +1,99 @@
+#ifndef HGS_H
+#define HGS_H
+
+#include <vector>
+#include <set>
+#include <memory>
+#include <random>
+#include <chrono>
+#include "Parser.h"
+#include "Solution.h"
+#include "Route.h"
+#include "VNS.h"
+
+/*
+ * Clase HGS
+ * Descripción: Implementa la metaheurística Hybrid Genetic Search para el CVRP. Cada
+ * individuo se representa como un tour gigante (secuencia de clientes sin bodega) que el
+ * procedimiento Split corta en rutas de forma óptima. Los hijos se generan con el cruce
+ * OX, se educan con las vecindades de VNS y se insertan en una subpoblación factible o
+ * infactible (capacidad penalizada). La supervivencia combina costo y contribución a la
+ * diversidad (distancia de pares rotos), y la penalización se ajusta para mantener una
+ * fracción objetivo de hijos factibles.
+ */
+class HGS {
+public:
+    explicit HGS(const Parser* parser);
+
+    Solution optimize(const Solution& initialSol, double timeLimitSeconds);
+
+    void setPopulationSize(int minSize, int generationSize) { mu = minSize; lambda = generationSize; }
+    void setSeed(unsigned int seed) { rng.seed(seed); }
+    double getCapacityPenalty() const { return penaltyCapacity; }
+
+    // Operadores del ciclo genético, públicos para poder probarlos de forma aislada
+    std::vector<int> crossoverOX(const std::vector<int>& parent1, const std::vector<int>& parent2);
+    Solution         split(const std::vector<int>& giantTour) const;
+    double           brokenPairsDistance(const Solution& a, const Solution& b) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+     * Estructura Individual
+     * Descripción: Solución de la población con su tour gigante, su costo penalizado y la
+     * lista de distancias (pares rotos) al resto de su subpoblación, ordenada de menor a mayor.
+     */
+    struct Individual {
+        Solution         solution;
+        std::vector<int> giantTour;
+        std::vector<int> successor;      // sucesor de cada cliente (1 = bodega)
+        std::vector<int> predecessor;    // predecesor de cada cliente (1 = bodega)
+        double           distance = 0.0; // costo de ruteo sin penalización
+        int              excess   = 0;   // exceso total de carga sobre Q
+        double           penalizedCost = 0.0;
+        double           biasedFitness = 0.0;
+        std::multiset<std::pair<double, Individual*>> proximity;
+    };
+    typedef std::vector<std::unique_ptr<Individual>> SubPopulation;
+
+    const Parser* parserData;
+    VNS           vns;
+    std::mt19937  rng;
+
+    int    mu     = 25;     // tamaño mínimo de cada subpoblación
+    int    lambda = 40;     // hijos antes de la selección de sobrevivientes
+    double penaltyCapacity = 1.0;
+
+    SubPopulation feasiblePop;
+    SubPopulation infeasiblePop;
+    std::vector<char> recentFeasible;   // factibilidad de los últimos hijos educados
+
+    static constexpr int    NB_ELITE          = 4;
+    static constexpr int    NB_CLOSE          = 5;
+    static constexpr int    PENALTY_WINDOW    = 100;
+    static constexpr double TARGET_FEASIBLE   = 0.2;
+    static constexpr double MAX_LOAD_FACTOR   = 1.5;    // Split no crea rutas con más carga que esto * Q
+    static constexpr int    ITER_NO_IMPROVE   = 5000;
+    static constexpr double REPAIR_PROBABILITY = 0.5;
+
+    // ── Representación ────────────────────────────────────────
+    std::vector<int> randomGiantTour();
+    std::vector<int> extractGiantTour(const Solution& sol) const;
+
+    // ── Ciclo de vida de los individuos ───────────────────────
+    std::unique_ptr<Individual> makeIndividual(const Solution& sol) const;
+    void educate(Solution& sol, Clock::time_point deadline);
+    bool repair(Solution& sol, Clock::time_point deadline);
+
+    // ── Población ─────────────────────────────────────────────
+    bool        addIndividual(std::unique_ptr<Individual> indiv, Solution& bestSol);
+    double      brokenPairsDistance(const Individual& a, const Individual& b) const;
+    void        updateBiasedFitness(SubPopulation& pop) const;
+    void        removeWorst(SubPopulation& pop);
+    const Individual& binaryTournament();
+    void        managePenalty();
+    void        initializePopulation(const Solution& initialSol, Solution& bestSol, Clock::time_point deadline);
+};
+
+#endif // HGS_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <vector>
 #include <algorithm> 
 #include <iostream>
+#include <climits>
 
 using namespace std;
 
@@ -19,23 +20,336 @@ KOpt::KOpt(const Parser* parser) : parserData(parser) {}
  */
 Solution KOpt::optimize(const Solution& initialSolution) {
     Solution improvedSolution(parserData);
-    
-    for (const auto& route : initialSolution.getRoutes()) {
-        Route optimized = optimizeRoute(route);
-        improvedSolution.addRoute(optimized);
+    const vector<Route>& routes = initialSolution.getRoutes();
+
+    // Las rutas ya vistas (o ya optimizadas) se resuelven con una consulta a la caché
+    // Las rutas cortas resueltas con DP exacto se memorizan por su conjunto de clientes
+    vector<Route> optimized(routes);
+    vector<int> pending;
+    vector<int> setKey;
+    for (size_t r = 0; r < routes.size(); ++r) {
+        const vector<int>& path = routes[r].getPath();
+        const vector<int>* cached = findCached(exactSetKey(path, setKey) ? setKey : path);
+        if (cached) {
+            optimized[r] = Route(parserData->getCapacity(), parserData, *cached);
+        } else {
+            pending.push_back(r);
+        }
+    }
+
+    if (numThreads <= 1 || pending.size() < 2) {
+        for (int r : pending) {
+            optimized[r] = optimizeRoute(routes[r]);
+        }
+    } else {
+        // Rutas largas primero: los hilos que terminan antes reclaman las cortas restantes
+        prepareWorkers();
+        stable_sort(pending.begin(), pending.end(), [&](int a, int b) {
+            return routes[a].getPath().size() > routes[b].getPath().size();
+        });
+
+        // Cada ruta se optimiza de forma independiente y se guarda en su posición original,
+        // así el resultado es idéntico al de la versión secuencial
+        pool->run(pending.size(), [&](int task, int worker) {
+            int r = pending[task];
+            optimized[r] = workerOpts[worker]->optimizeRoute(routes[r]);
+        });
+    }
+
+    for (int r : pending) {
+        const vector<int>& path = routes[r].getPath();
+        storeCached(exactSetKey(path, setKey) ? setKey : path, optimized[r].getPath());
+    }
+    for (const auto& route : optimized) {
+        improvedSolution.addRoute(route);
     }
-    
     return improvedSolution;
 }
 
 /*
- * Descripción: Optimiza una sola ruta aplicando intercambios 3-OPT exhaustivos
- * hasta que no se encuentren más mejoras (mínimo local).
+ * Descripción: Define cuántos hilos usa optimize() para procesar rutas en paralelo.
+ * Entrada: Número de hilos (1 = secuencial).
+ * Salida: Ninguna.
+ */
+void KOpt::setNumThreads(int threads) {
+    threads = max(1, threads);
+    if (threads == numThreads) return;
+    numThreads = threads;
+    pool.reset();
+    workerOpts.clear();
+}
+
+/*
+ * Descripción: Define el número máximo de rutas memorizadas (0 desactiva la caché).
+ * Entrada: Número de entradas.
+ * Salida: Ninguna.
+ */
+void KOpt::setCacheCapacity(size_t entries) {
+    cacheCapacity = entries;
+    while (cacheEntries.size() > cacheCapacity) {
+        cacheIndex.erase(cacheEntries.back().first);
+        cacheEntries.pop_back();
+    }
+}
+
+/*
+ * Descripción: Descarta todas las rutas memorizadas (los contadores se conservan).
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void KOpt::clearCache() {
+    cacheEntries.clear();
+    cacheIndex.clear();
+}
+
+/*
+ * Descripción: Hash FNV-1a de la secuencia de nodos de una ruta.
+ * Entrada: Secuencia de nodos.
+ * Salida: Valor hash.
+ */
+size_t KOpt::PathHash::operator()(const vector<int>& path) const {
+    unsigned long long h = 1469598103934665603ULL;
+    for (int node : path) {
+        h ^= (unsigned int)node;
+        h *= 1099511628211ULL;
+    }
+    return (size_t)h;
+}
+
+/*
+ * Descripción: Busca una secuencia en la caché y, si está, la marca como la más reciente.
+ * Entrada: Secuencia de nodos de la ruta.
+ * Salida: Puntero a la secuencia optimizada, o nullptr si no está memorizada.
+ */
+const vector<int>* KOpt::findCached(const vector<int>& path) {
+    if (cacheCapacity == 0) return nullptr;
+
+    auto it = cacheIndex.find(path);
+    if (it == cacheIndex.end()) {
+        ++cacheMisses;
+        return nullptr;
+    }
+    ++cacheHits;
+    cacheEntries.splice(cacheEntries.begin(), cacheEntries, it->second);
+    return &it->second->second;
+}
+
+/*
+ * Descripción: Memoriza el resultado de optimizar una ruta. También se registra la salida
+ * como su propio resultado, para que volver a pulir una ruta ya optimizada sea un acierto.
+ * Entrada: Secuencia original y secuencia optimizada.
+ * Salida: Ninguna.
+ */
+void KOpt::storeCached(const vector<int>& input, const vector<int>& output) {
+    if (cacheCapacity == 0) return;
+
+    for (const vector<int>* key : { &input, &output }) {
+        auto it = cacheIndex.find(*key);
+        if (it != cacheIndex.end()) {
+            it->second->second = output;
+            cacheEntries.splice(cacheEntries.begin(), cacheEntries, it->second);
+            continue;
+        }
+        cacheEntries.emplace_front(*key, output);
+        cacheIndex.emplace(*key, cacheEntries.begin());
+        if (cacheEntries.size() > cacheCapacity) {
+            cacheIndex.erase(cacheEntries.back().first);
+            cacheEntries.pop_back();
+        }
+    }
+}
+
+/*
+ * Descripción: Crea (la primera vez) el pool de hilos y un KOpt por trabajador, y copia
+ * en cada uno la configuración actual del vecindario.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void KOpt::prepareWorkers() {
+    if (!pool) {
+        pool.reset(new ThreadPool(numThreads));
+        for (int w = 0; w < pool->size(); ++w) {
+            workerOpts.emplace_back(new KOpt(parserData));
+        }
+    }
+    for (auto& worker : workerOpts) {
+        worker->mode             = mode;
+        worker->policy           = policy;
+        worker->neighborListSize = neighborListSize;
+        worker->lkDepth          = lkDepth;
+        worker->finalThreeOpt    = finalThreeOpt;
+        worker->exactThreshold   = exactThreshold;
+    }
+}
+
+/*
+ * Descripción: Define el largo máximo (en clientes) de las rutas que se resuelven de forma
+ * exacta con programación dinámica (Held-Karp). 0 desactiva el optimizador exacto.
+ * Entrada: Número de clientes (se acota a MAX_EXACT_CLIENTS).
+ * Salida: Ninguna.
+ */
+void KOpt::setExactThreshold(int clients) {
+    exactThreshold = max(0, min(clients, MAX_EXACT_CLIENTS));
+    clearCache();
+}
+
+/*
+ * Descripción: Indica si una ruta se resuelve con el DP exacto y, en ese caso, construye la
+ * clave de caché basada en su conjunto de clientes: el óptimo no depende del orden de entrada.
+ * La clave comienza con -1 para no confundirse con una secuencia (que comienza en la bodega).
+ * Entrada: Secuencia de la ruta, buffer de salida para la clave.
+ * Salida: true si la ruta es apta para el DP exacto.
+ */
+bool KOpt::exactSetKey(const vector<int>& path, vector<int>& key) const {
+    int clients = (int)path.size() - 2;
+    if (clients < 3 || clients > exactThreshold) return false;
+
+    key.assign(1, -1);
+    key.insert(key.end(), path.begin() + 1, path.end() - 1);
+    sort(key.begin() + 1, key.end());
+    return true;
+}
+
+/*
+ * Descripción: Optimiza una sola ruta. Las rutas de hasta exactThreshold clientes se
+ * resuelven de forma exacta; el resto con el vecindario configurado. En los modos
+ * distintos de ThreeOpt se puede solicitar además un pulido 3-OPT final.
+ * Todos los movimientos se aplican in-place sobre un buffer reutilizado entre llamadas.
  * Entrada: Objeto Route a optimizar.
  * Salida: Nuevo objeto Route con la secuencia optimizada.
  */
 Route KOpt::optimizeRoute(const Route& route) {
-    vector<int> path = route.getPath();
+    const vector<int>& original = route.getPath();
+    workPath.assign(original.begin(), original.end());
+
+    int clients = (int)workPath.size() - 2;
+    if (clients >= 3 && clients <= exactThreshold) {
+        exactOptimize(workPath);
+    } else if (mode == Mode::TwoOptOrOpt || mode == Mode::LinKernighan) {
+        localSearch(workPath);
+        if (finalThreeOpt) threeOpt(workPath);
+    } else if (mode == Mode::OrThreeOpt) {
+        orThreeOpt(workPath);
+        if (finalThreeOpt) threeOpt(workPath);
+    } else {
+        threeOpt(workPath);
+    }
+
+    return Route(parserData->getCapacity(), parserData, workPath);
+}
+
+/*
+ * Descripción: Núcleo Held-Karp. cost[mask*m + j] es el costo mínimo de salir de la bodega,
+ * visitar exactamente los clientes de 'mask' y terminar en j; parent guarda el predecesor.
+ * Inline para que, con m constante en tiempo de compilación, el compilador especialice
+ * los bucles de cada tamaño.
+ * Entrada: Número de clientes m, matriz local (m+1)x(m+1) con la bodega en el índice 0,
+ * tablas de trabajo y arreglo de salida con el orden óptimo (índices locales 0..m-1).
+ * Salida: Ninguna.
+ */
+static inline void heldKarp(int m, const int* dist, int* cost, unsigned char* parent, int* order) {
+    const int stride = m + 1;
+    const int full   = (1 << m) - 1;
+
+    for (int j = 0; j < m; ++j) {
+        cost[(1 << j) * m + j] = dist[j + 1];
+    }
+
+    for (int mask = 1; mask <= full; ++mask) {
+        for (int j = 0; j < m; ++j) {
+            if (!(mask & (1 << j)) || mask == (1 << j)) continue;
+
+            int prev = mask ^ (1 << j);
+            int best = INT_MAX, arg = 0;
+            for (int k = 0; k < m; ++k) {
+                if (!(prev & (1 << k))) continue;
+                int value = cost[prev * m + k] + dist[(k + 1) * stride + j + 1];
+                if (value < best) { best = value; arg = k; }
+            }
+            cost[mask * m + j]   = best;
+            parent[mask * m + j] = (unsigned char)arg;
+        }
+    }
+
+    int best = INT_MAX, last = 0;
+    for (int j = 0; j < m; ++j) {
+        int value = cost[full * m + j] + dist[(j + 1) * stride];
+        if (value < best) { best = value; last = j; }
+    }
+
+    int mask = full;
+    for (int pos = m - 1; pos >= 0; --pos) {
+        order[pos] = last;
+        int prev = parent[mask * m + last];
+        mask ^= (1 << last);
+        last = prev;
+    }
+}
+
+/*
+ * Descripción: Kernel Held-Karp de tamaño fijo con tablas en la pila.
+ * Entrada: Matriz local de distancias y arreglo de salida con el orden óptimo.
+ * Salida: Ninguna.
+ */
+template <int M>
+static void heldKarpFixed(const int* dist, int* order) {
+    int           cost[(1 << M) * M];
+    unsigned char parent[(1 << M) * M];
+    heldKarp(M, dist, cost, parent, order);
+}
+
+/*
+ * Descripción: Resuelve de forma exacta el TSP de una ruta corta. Los clientes se ordenan
+ * antes de resolver, de modo que el resultado depende sólo del conjunto de clientes.
+ * Hasta 8 clientes se usan kernels especializados en compilación; por
+ * encima, las tablas reutilizadas de la instancia.
+ * Entrada: Secuencia de nodos de la ruta (incluye la bodega en ambos extremos).
+ * Salida: Ninguna (modifica la secuencia in-place).
+ */
+void KOpt::exactOptimize(vector<int>& path) {
+    const int m = (int)path.size() - 2;
+    const int depot = path[0];
+    if (m < 1 || m > MAX_EXACT_CLIENTS) return;
+
+    vector<int>& nodes = exactNodes;
+    nodes.assign(1, depot);
+    nodes.insert(nodes.end(), path.begin() + 1, path.end() - 1);
+    sort(nodes.begin() + 1, nodes.end());
+
+    int dist[(MAX_EXACT_CLIENTS + 1) * (MAX_EXACT_CLIENTS + 1)];
+    for (int a = 0; a <= m; ++a) {
+        for (int b = 0; b <= m; ++b) {
+            dist[a * (m + 1) + b] = parserData->getDistance(nodes[a], nodes[b]);
+        }
+    }
+
+    int order[MAX_EXACT_CLIENTS];
+    switch (m) {
+        case 3: heldKarpFixed<3>(dist, order); break;
+        case 4: heldKarpFixed<4>(dist, order); break;
+        case 5: heldKarpFixed<5>(dist, order); break;
+        case 6: heldKarpFixed<6>(dist, order); break;
+        case 7: heldKarpFixed<7>(dist, order); break;
+        case 8: heldKarpFixed<8>(dist, order); break;
+        default:
+            exactCost.resize((size_t)(1 << m) * m);
+            exactParent.resize((size_t)(1 << m) * m);
+            heldKarp(m, dist, exactCost.data(), exactParent.data(), order);
+            break;
+    }
+
+    for (int pos = 0; pos < m; ++pos) {
+        path[pos + 1] = nodes[order[pos] + 1];
+    }
+}
+
+/*
+ * Descripción: Aplica intercambios 3-OPT exhaustivos sobre la secuencia
+ * hasta que no se encuentren más mejoras (mínimo local).
+ * Entrada: Secuencia de nodos de la ruta (incluye la bodega en ambos extremos).
+ * Salida: Ninguna (modifica la secuencia in-place).
+ */
+void KOpt::threeOpt(vector<int>& path) const {
     bool improvement = true;
     
     while (improvement) {
@@ -87,59 +401,470 @@ Route KOpt::optimizeRoute(const Route& route) {
                     if (d6 - d0 < best_delta) { best_delta = d6 - d0; best_opt = 6; }
                     if (d7 - d0 < best_delta) { best_delta = d7 - d0; best_opt = 7; }
                     
-                    // Aplicar la mejor reconexión encontrada
+                    // Aplicar la mejor reconexión encontrada directamente sobre la secuencia.
+                    // S2 = [first, mid), S3 = [mid, last); |S3| = k - j.
                     if (best_opt > 0) {
                         improvement = true;
-                        
-                        vector<int> S1(path.begin(), path.begin() + i + 1);
-                        vector<int> S2(path.begin() + i + 1, path.begin() + j + 1);
-                        vector<int> S3(path.begin() + j + 1, path.begin() + k + 1);
-                        vector<int> S4(path.begin() + k + 1, path.end());
-                        
-                        vector<int> S2_rev = S2; std::reverse(S2_rev.begin(), S2_rev.end());
-                        vector<int> S3_rev = S3; std::reverse(S3_rev.begin(), S3_rev.end());
-                        
-                        vector<int> newPath = S1; 
-                        
-                        if (best_opt == 1) {
-                            newPath.insert(newPath.end(), S2_rev.begin(), S2_rev.end());
-                            newPath.insert(newPath.end(), S3.begin(), S3.end());
-                        } else if (best_opt == 2) {
-                            newPath.insert(newPath.end(), S2.begin(), S2.end());
-                            newPath.insert(newPath.end(), S3_rev.begin(), S3_rev.end());
-                        } else if (best_opt == 3) {
-                            newPath.insert(newPath.end(), S2_rev.begin(), S2_rev.end());
-                            newPath.insert(newPath.end(), S3_rev.begin(), S3_rev.end());
-                        } else if (best_opt == 4) {
-                            newPath.insert(newPath.end(), S3.begin(), S3.end());
-                            newPath.insert(newPath.end(), S2.begin(), S2.end());
-                        } else if (best_opt == 5) {
-                            newPath.insert(newPath.end(), S3.begin(), S3.end());
-                            newPath.insert(newPath.end(), S2_rev.begin(), S2_rev.end());
-                        } else if (best_opt == 6) {
-                            newPath.insert(newPath.end(), S3_rev.begin(), S3_rev.end());
-                            newPath.insert(newPath.end(), S2.begin(), S2.end());
-                        } else if (best_opt == 7) {
-                            newPath.insert(newPath.end(), S3_rev.begin(), S3_rev.end());
-                            newPath.insert(newPath.end(), S2_rev.begin(), S2_rev.end());
+
+                        auto first = path.begin() + i + 1;
+                        auto mid   = path.begin() + j + 1;
+                        auto last  = path.begin() + k + 1;
+
+                        switch (best_opt) {
+                            case 1: reverse(first, mid); break;                             // S2' S3
+                            case 2: reverse(mid, last); break;                              // S2 S3'
+                            case 3: reverse(first, mid); reverse(mid, last); break;         // S2' S3'
+                            case 4: rotate(first, mid, last); break;                        // S3 S2
+                            case 5: rotate(first, mid, last);
+                                    reverse(first + (k - j), last); break;                  // S3 S2'
+                            case 6: rotate(first, mid, last);
+                                    reverse(first, first + (k - j)); break;                 // S3' S2
+                            case 7: reverse(first, last); break;                            // S3' S2'
                         }
-                        
-                        newPath.insert(newPath.end(), S4.begin(), S4.end());
-                        
-                        path = newPath; 
                     }
                 }
             }
         }
     }
-    
-    Route optimizedRoute(parserData->getCapacity(), parserData);
-    
-    for (size_t i = 1; i < path.size() - 1; ++i) {
-        optimizedRoute.addClient(path[i]);
+}
+
+// ─────────────────────────────────────────────────────────────
+// 2-OPT + Or-Opt con listas de vecinos y don't-look bits
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Búsqueda local 2-OPT + Or-Opt (o cadenas Lin-Kernighan + Or-Opt en modo
+ * LinKernighan). Mantiene una pila de nodos activos; cada nodo solo se explora contra
+ * sus K vecinos más cercanos dentro de la ruta y, si no produce mejora, queda inactivo
+ * (don't-look bit) hasta que un movimiento modifique alguna de sus aristas.
+ * Entrada: Secuencia de nodos de la ruta (incluye la bodega en ambos extremos).
+ * Salida: Ninguna (modifica la secuencia in-place).
+ */
+void KOpt::localSearch(vector<int>& path) {
+    int n = path.size();
+    if (n < 4) return;
+
+    int dimension = parserData->getDimension();
+    if ((int)position.size() != dimension + 1) {
+        position.assign(dimension + 1, -1);
+        dontLook.assign(dimension + 1, 1);
+        routeNeighbors.assign(dimension + 1, vector<int>());
+    }
+
+    updatePositions(path, 1, n - 2);
+    buildRouteNeighbors(path);
+
+    activeNodes.clear();
+    for (int i = n - 2; i >= 1; --i) {
+        dontLook[path[i]] = 0;
+        activeNodes.push_back(path[i]);
+    }
+
+    while (!activeNodes.empty()) {
+        int node = activeNodes.back();
+        activeNodes.pop_back();
+        dontLook[node] = 1;
+
+        bool improved = (mode == Mode::LinKernighan)
+            ? (improveLinKernighan(path, node, true) || improveLinKernighan(path, node, false)
+               || improveOrOpt(path, node))
+            : (improveTwoOpt(path, node) || improveOrOpt(path, node));
+        if (improved) activate(node);
+    }
+
+    for (int i = 1; i < n - 1; ++i) position[path[i]] = -1;
+}
+
+/*
+ * Descripción: Construye, para cada nodo de la ruta (clientes y bodega), la lista de sus
+ * K vecinos más cercanos que también pertenecen a la ruta, en orden creciente.
+ * Entrada: Secuencia de nodos de la ruta.
+ * Salida: Ninguna (actualiza routeNeighbors).
+ */
+void KOpt::buildRouteNeighbors(const vector<int>& path) {
+    int n = path.size();
+
+    for (int i = 0; i < n - 1; ++i) {
+        int a = path[i];
+        candidateBuffer.clear();
+        for (int j = 0; j < n - 1; ++j) {
+            if (j == i) continue;
+            candidateBuffer.push_back({parserData->getDistance(a, path[j]), path[j]});
+        }
+
+        int k = min(neighborListSize, (int)candidateBuffer.size());
+        partial_sort(candidateBuffer.begin(), candidateBuffer.begin() + k, candidateBuffer.end());
+
+        vector<int>& list = routeNeighbors[a];
+        list.clear();
+        for (int t = 0; t < k; ++t) list.push_back(candidateBuffer[t].second);
+    }
+}
+
+/*
+ * Descripción: Actualiza el índice de posición de los nodos en un rango de la secuencia.
+ * Entrada: Secuencia de nodos, índices inicial y final (inclusive).
+ * Salida: Ninguna.
+ */
+void KOpt::updatePositions(const vector<int>& path, int from, int to) {
+    for (int i = from; i <= to; ++i) {
+        if (path[i] != 1) position[path[i]] = i;
+    }
+}
+
+/*
+ * Descripción: Reactiva un nodo apagando su don't-look bit. La bodega nunca se activa.
+ * Entrada: ID del nodo.
+ * Salida: Ninguna.
+ */
+void KOpt::activate(int node) {
+    if (node != 1 && dontLook[node]) {
+        dontLook[node] = 0;
+        activeNodes.push_back(node);
+    }
+}
+
+/*
+ * Descripción: Busca un movimiento 2-OPT mejorador que agregue la arista (node, c),
+ * con c entre los vecinos cercanos de node. Se consideran las dos aristas incidentes
+ * a node como candidatas a romperse y se aplica el primer movimiento mejorador.
+ * Entrada: Secuencia de nodos, ID del nodo a explorar.
+ * Salida: Booleano indicando si se aplicó un movimiento.
+ */
+bool KOpt::improveTwoOpt(vector<int>& path, int node) {
+    int n = path.size();
+    int i = position[node];
+
+    // Dirección sucesor: se rompe (node, path[i+1])
+    int b = path[i + 1];
+    int dab = parserData->getDistance(node, b);
+    for (int c : routeNeighbors[node]) {
+        int dac = parserData->getDistance(node, c);
+        if (dac >= dab) break;
+
+        int j = (c == 1) ? 0 : position[c];
+        int d = path[j + 1];
+        int gain = dab + parserData->getDistance(c, d) - dac - parserData->getDistance(b, d);
+        if (gain > 0) {
+            int lo = min(i, j), hi = max(i, j);
+            reverse(path.begin() + lo + 1, path.begin() + hi + 1);
+            updatePositions(path, lo + 1, hi);
+            activate(b); activate(c); activate(d);
+            return true;
+        }
+    }
+
+    // Dirección predecesor: se rompe (path[i-1], node)
+    b = path[i - 1];
+    dab = parserData->getDistance(node, b);
+    for (int c : routeNeighbors[node]) {
+        int dac = parserData->getDistance(node, c);
+        if (dac >= dab) break;
+
+        int j = (c == 1) ? n - 1 : position[c];
+        int d = path[j - 1];
+        int gain = dab + parserData->getDistance(d, c) - dac - parserData->getDistance(b, d);
+        if (gain > 0) {
+            int lo = min(i, j), hi = max(i, j);
+            reverse(path.begin() + lo, path.begin() + hi);
+            updatePositions(path, lo, hi - 1);
+            activate(b); activate(c); activate(d);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Descripción: Busca un movimiento Or-Opt mejorador que reubique el segmento de
+ * 1 a 3 clientes que comienza en node, dejándolo adyacente a uno de sus vecinos
+ * cercanos (a continuación del vecino, o antes de él en sentido invertido).
+ * Entrada: Secuencia de nodos, ID del nodo a explorar.
+ * Salida: Booleano indicando si se aplicó un movimiento.
+ */
+bool KOpt::improveOrOpt(vector<int>& path, int node) {
+    int n = path.size();
+    int i = position[node];
+
+    for (int segLen = 1; segLen <= 3; ++segLen) {
+        int e = i + segLen - 1;
+        if (e > n - 2) break;
+
+        int p    = path[i - 1];
+        int last = path[e];
+        int nx   = path[e + 1];
+        int removeGain = parserData->getDistance(p, node)
+                       + parserData->getDistance(last, nx)
+                       - parserData->getDistance(p, nx);
+        if (removeGain <= 0) continue;
+
+        for (int c : routeNeighbors[node]) {
+            // Opción A: c -> [node .. last] -> sucesor de c
+            int j = (c == 1) ? 0 : position[c];
+            if ((j < i || j > e) && j != i - 1 && j <= n - 2) {
+                int v = path[j + 1];
+                int insertCost = parserData->getDistance(c, node)
+                               + parserData->getDistance(last, v)
+                               - parserData->getDistance(c, v);
+                if (insertCost < removeGain) {
+                    moveSegment(path, i, e, j, false);
+                    updatePositions(path, min(i, j + 1), max(e, j));
+                    activate(p); activate(nx); activate(c); activate(v); activate(last);
+                    return true;
+                }
+            }
+
+            // Opción B: predecesor de c -> [last .. node] -> c
+            j = (c == 1) ? n - 1 : position[c];
+            if ((j < i || j > e) && j - 1 != e && j >= 1) {
+                int u = path[j - 1];
+                int insertCost = parserData->getDistance(u, last)
+                               + parserData->getDistance(node, c)
+                               - parserData->getDistance(u, c);
+                if (insertCost < removeGain) {
+                    moveSegment(path, i, e, j - 1, true);
+                    updatePositions(path, min(i, j), max(e, j - 1));
+                    activate(p); activate(nx); activate(c); activate(u); activate(last);
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Lin-Kernighan: cadenas secuenciales de profundidad variable
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Construye una cadena Lin-Kernighan que parte rompiendo la arista entre t1 y
+ * su sucesor (forward) o predecesor. En cada nivel se elige t3 entre los vecinos cercanos
+ * de t2 respetando el criterio de ganancia positiva, se cierra el tour con un intercambio
+ * 2-OPT (agregando (t2,t3) y (t4,t1)) y la arista de cierre pasa a ser la siguiente a romper.
+ * La cadena llega hasta lkDepth intercambios (un movimiento secuencial de hasta lkDepth-opt)
+ * y al final se deshacen los niveles posteriores al de mayor ganancia acumulada. En el
+ * primer nivel se prueban hasta LK_FIRST_LEVEL_BREADTH alternativas (backtracking).
+ * Entrada: Secuencia de nodos, cliente t1, orientación inicial.
+ * Salida: Booleano indicando si se aplicó una cadena con ganancia estrictamente positiva.
+ */
+bool KOpt::improveLinKernighan(vector<int>& path, int t1, bool forward) {
+    for (int rank = 0; rank < LK_FIRST_LEVEL_BREADTH; ++rank) {
+        int status = linKernighanChain(path, t1, forward, rank);
+        if (status > 0) return true;
+        if (status < 0) break;
+    }
+    return false;
+}
+
+/*
+ * Descripción: Ejecuta una cadena Lin-Kernighan en la que el primer nivel toma el
+ * candidato t3 de posición 'firstRank' (según la ganancia g1 + d(t3,t4)) y los niveles
+ * siguientes el mejor candidato disponible.
+ * Entrada: Secuencia de nodos, cliente t1, orientación inicial, rango del primer candidato.
+ * Salida: 1 si se aplicó una cadena mejoradora, 0 si no hubo mejora, -1 si no existe
+ * un candidato de ese rango en el primer nivel.
+ */
+int KOpt::linKernighanChain(vector<int>& path, int t1, bool forward, int firstRank) {
+    lkRanges.clear();
+    lkNodes.clear();
+
+    int gain      = 0;   // ganancia acumulada del tour cerrado
+    int bestGain  = 0;
+    int bestDepth = 0;
+
+    for (int depth = 1; depth <= lkDepth; ++depth) {
+        int p  = position[t1];
+        int t2 = forward ? path[p + 1] : path[p - 1];
+        int openGain = gain + parserData->getDistance(t1, t2);
+
+        int bestT3 = -1, bestT4 = -1, bestQ = -1;
+        int bestValue = INT_MIN;
+        lkFirstLevel.clear();
+
+        for (int t3 : routeNeighbors[t2]) {
+            int g1 = openGain - parserData->getDistance(t2, t3);
+            if (g1 <= 0) break;
+            if (t3 == 1 || t3 == t1) continue;
+            if (find(lkNodes.begin(), lkNodes.end(), t3) != lkNodes.end()) continue;
+
+            int q = position[t3];
+            int t4;
+            if (forward) {
+                if (!(q > p + 2 || q < p)) continue;
+                t4 = path[q - 1];
+            } else {
+                if (!(q < p - 2 || q > p)) continue;
+                t4 = path[q + 1];
+            }
+
+            int value = g1 + parserData->getDistance(t3, t4);
+            if (depth == 1) {
+                lkFirstLevel.push_back({value, t3});
+            } else if (value > bestValue) {
+                bestValue = value;
+                bestT3 = t3; bestT4 = t4; bestQ = q;
+            }
+        }
+
+        if (depth == 1) {
+            if (firstRank >= (int)lkFirstLevel.size()) return -1;
+            nth_element(lkFirstLevel.begin(), lkFirstLevel.begin() + firstRank, lkFirstLevel.end(),
+                        [](const pair<int,int>& a, const pair<int,int>& b) { return a.first > b.first; });
+            bestValue = lkFirstLevel[firstRank].first;
+            bestT3    = lkFirstLevel[firstRank].second;
+            bestQ     = position[bestT3];
+            bestT4    = forward ? path[bestQ - 1] : path[bestQ + 1];
+        }
+
+        if (bestT3 == -1) break;
+
+        int lo, hi;
+        if (forward) {
+            if (bestQ > p) { lo = p + 1; hi = bestQ - 1; }
+            else           { lo = bestQ; hi = p; forward = false; }
+        } else {
+            if (bestQ < p) { lo = bestQ + 1; hi = p - 1; }
+            else           { lo = p; hi = bestQ; forward = true; }
+        }
+        reverse(path.begin() + lo, path.begin() + hi + 1);
+        updatePositions(path, lo, hi);
+        lkRanges.push_back({lo, hi});
+
+        gain = bestValue - parserData->getDistance(bestT4, t1);
+        lkNodes.push_back(bestT3);
+        lkNodes.push_back(t2);
+        lkNodes.push_back(bestT4);
+
+        if (gain > bestGain) {
+            bestGain  = gain;
+            bestDepth = depth;
+        }
+    }
+
+    // Deshacer los intercambios posteriores al mejor nivel (cada inversión es su propia inversa)
+    for (int d = (int)lkRanges.size(); d > bestDepth; --d) {
+        int lo = lkRanges[d - 1].first, hi = lkRanges[d - 1].second;
+        reverse(path.begin() + lo, path.begin() + hi + 1);
+        updatePositions(path, lo, hi);
+    }
+
+    if (bestGain <= 0) return 0;
+
+    for (int d = 0; d < bestDepth; ++d) {
+        activate(lkNodes[3 * d]);
+        activate(lkNodes[3 * d + 1]);
+        activate(lkNodes[3 * d + 2]);
+    }
+    return 1;
+}
+
+/*
+ * Descripción: Reubica el segmento path[i..e] entre las posiciones k y k+1 de la secuencia
+ * original (k fuera de [i-1, e]), opcionalmente invirtiéndolo. Usa std::rotate in-place.
+ * Entrada: Secuencia de nodos, extremos del segmento, arista destino, indicador de inversión.
+ * Salida: Ninguna (modifica la secuencia in-place).
+ */
+void KOpt::moveSegment(vector<int>& path, int i, int e, int k, bool reversed) const {
+    int segLen = e - i + 1;
+    int segStart;
+    if (k < i) {
+        rotate(path.begin() + k + 1, path.begin() + i, path.begin() + e + 1);
+        segStart = k + 1;
+    } else {
+        rotate(path.begin() + i, path.begin() + e + 1, path.begin() + k + 1);
+        segStart = k - segLen + 1;
+    }
+    if (reversed) reverse(path.begin() + segStart, path.begin() + segStart + segLen);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Or-3OPT: 2-OPT + inserción de segmentos, evaluación O(L^2)
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Vecindario Or-3OPT. Subconjunto del 3-OPT formado por la reubicación de
+ * segmentos de 1 a 3 clientes (en ambos sentidos) más los movimientos 2-OPT, que puede
+ * evaluarse completo en O(L^2). Según la política configurada aplica el mejor movimiento
+ * de la pasada (BestImprovement) o el primero que mejora (FirstImprovement), y repite
+ * hasta alcanzar un mínimo local.
+ * Entrada: Secuencia de nodos de la ruta (incluye la bodega en ambos extremos).
+ * Salida: Ninguna (modifica la secuencia in-place).
+ */
+void KOpt::orThreeOpt(vector<int>& path) const {
+    int n = path.size();
+    if (n < 4) return;
+
+    bool firstImprovement = (policy == Policy::FirstImprovement);
+
+    while (true) {
+        int bestDelta = 0;
+        int bestType  = 0;   // 1 = 2-OPT, 2 = segmento
+        int bestI = -1, bestE = -1, bestK = -1;
+        bool bestReversed = false;
+
+        // ── 2-OPT: invertir path[i+1..j] ──
+        for (int i = 0; i <= n - 3; ++i) {
+            int a = path[i], b = path[i + 1];
+            int dab = parserData->getDistance(a, b);
+            for (int j = i + 2; j <= n - 2; ++j) {
+                int c = path[j], d = path[j + 1];
+                int delta = parserData->getDistance(a, c) + parserData->getDistance(b, d)
+                          - dab - parserData->getDistance(c, d);
+                if (delta < bestDelta) {
+                    bestDelta = delta; bestType = 1; bestI = i; bestK = j;
+                    if (firstImprovement) break;
+                }
+            }
+            if (firstImprovement && bestType) break;
+        }
+
+        // ── Inserción de segmentos path[i..e] entre path[k] y path[k+1] ──
+        for (int i = 1; i <= n - 2 && !(firstImprovement && bestType); ++i) {
+            for (int segLen = 1; segLen <= 3 && !(firstImprovement && bestType); ++segLen) {
+                int e = i + segLen - 1;
+                if (e > n - 2) break;
+
+                int p = path[i - 1], first = path[i], last = path[e], nx = path[e + 1];
+                int removeGain = parserData->getDistance(p, first)
+                               + parserData->getDistance(last, nx)
+                               - parserData->getDistance(p, nx);
+                if (removeGain <= 0) continue;
+
+                for (int k = 0; k <= n - 2; ++k) {
+                    if (k >= i - 1 && k <= e) continue;
+                    int u = path[k], v = path[k + 1];
+                    int duv = parserData->getDistance(u, v);
+
+                    int fwd = parserData->getDistance(u, first) + parserData->getDistance(last, v) - duv;
+                    if (fwd - removeGain < bestDelta) {
+                        bestDelta = fwd - removeGain; bestType = 2;
+                        bestI = i; bestE = e; bestK = k; bestReversed = false;
+                        if (firstImprovement) break;
+                    }
+
+                    if (segLen > 1) {
+                        int rev = parserData->getDistance(u, last) + parserData->getDistance(first, v) - duv;
+                        if (rev - removeGain < bestDelta) {
+                            bestDelta = rev - removeGain; bestType = 2;
+                            bestI = i; bestE = e; bestK = k; bestReversed = true;
+                            if (firstImprovement) break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (bestType == 0) break;
+
+        if (bestType == 1) {
+            reverse(path.begin() + bestI + 1, path.begin() + bestK + 1);
+        } else {
+            moveSegment(path, bestI, bestE, bestK, bestReversed);
+        }
     }
-    
-    return optimizedRoute;
 }
 
 /*
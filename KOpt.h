@@ -1,27 +1,132 @@
 #ifndef KOPT_H
 #define KOPT_H
 
+#include <vector>
+#include <memory>
+#include <list>
+#include <unordered_map>
 #include "Solution.h"
 #include "Parser.h"
 #include "Route.h"
+#include "ThreadPool.h"
 
 /*
  * Clase KOpt
  * Descripción: Implementa la heurística de búsqueda local intra-ruta 3-OPT.
- * Se encarga de refinar iterativamente las rutas rompiendo hasta tres aristas 
+ * Se encarga de refinar iterativamente las rutas rompiendo hasta tres aristas
  * y reconectando los segmentos resultantes para encontrar un mínimo local.
+ * Opcionalmente ofrece vecindarios más baratos para rutas largas: 2-OPT + Or-Opt
+ * guiado por listas de vecinos y don't-look bits, Or-3OPT evaluado en O(L^2) o
+ * un motor de profundidad variable estilo Lin-Kernighan. Las rutas cortas pueden
+ * resolverse de forma exacta con Held-Karp. Las rutas optimizadas se
+ * memorizan en una caché LRU, de modo que las rutas no modificadas se resuelven
+ * con una consulta.
  */
 class KOpt {
+public:
+    /*
+     * Enum Mode
+     * Descripción: Vecindario intra-ruta utilizado al optimizar cada ruta.
+     *  - ThreeOpt:    barrido 3-OPT exhaustivo O(L^3) por pasada.
+     *  - TwoOptOrOpt: 2-OPT + Or-Opt restringidos a los vecinos más cercanos
+     *                 dentro de la ruta, con don't-look bits.
+     *  - OrThreeOpt:  subconjunto del 3-OPT (2-OPT + inserción de segmentos de
+     *                 hasta 3 clientes) evaluado completo en O(L^2) por pasada.
+     *  - LinKernighan: cadenas secuenciales de profundidad variable (estilo LK)
+     *                 guiadas por los vecinos cercanos, más Or-Opt.
+     */
+    enum class Mode { ThreeOpt, TwoOptOrOpt, OrThreeOpt, LinKernighan };
+
+    /*
+     * Enum Policy
+     * Descripción: Política de aceptación del modo OrThreeOpt: aplicar el mejor
+     * movimiento de la pasada o el primero que mejora.
+     */
+    enum class Policy { BestImprovement, FirstImprovement };
+
 private:
     const Parser* parserData;
 
+    Mode   mode             = Mode::ThreeOpt;
+    Policy policy           = Policy::BestImprovement;
+    int    neighborListSize = 10;
+    int    lkDepth          = 5;
+    bool   finalThreeOpt    = false;
+    int    numThreads       = 1;
+    int    exactThreshold   = 0;     // rutas de hasta este número de clientes se resuelven con DP exacto
+
+    static constexpr int MAX_EXACT_CLIENTS = 12;
+
+    // ── Caché LRU de rutas optimizadas: secuencia de entrada -> secuencia optimizada ──
+    struct PathHash {
+        size_t operator()(const std::vector<int>& path) const;
+    };
+    typedef std::list<std::pair<std::vector<int>, std::vector<int>>> CacheList;
+
+    size_t    cacheCapacity = 4096;
+    CacheList cacheEntries;                                          // el frente es la más reciente
+    std::unordered_map<std::vector<int>, CacheList::iterator, PathHash> cacheIndex;
+    long long cacheHits   = 0;
+    long long cacheMisses = 0;
+
+    // ── Paralelismo por ruta: un KOpt por trabajador con sus propios buffers ──
+    std::unique_ptr<ThreadPool>        pool;
+    std::vector<std::unique_ptr<KOpt>> workerOpts;
+
+    // ── Estructuras auxiliares reutilizadas entre llamadas ────
+    std::vector<int>                workPath;        // secuencia en optimización
+    std::vector<int>                position;        // índice de cada nodo en la ruta (-1 si no pertenece)
+    std::vector<char>               dontLook;        // 1 = nodo inactivo (no se vuelve a explorar)
+    std::vector<int>                activeNodes;     // pila de nodos activos
+    std::vector<std::vector<int>>   routeNeighbors;  // K vecinos más cercanos dentro de la ruta
+    std::vector<std::pair<int,int>> candidateBuffer;
+    std::vector<std::pair<int,int>> lkRanges;        // inversiones aplicadas por la cadena LK
+    std::vector<int>                lkNodes;         // (t3, t2, t4) de cada nivel de la cadena
+    std::vector<std::pair<int,int>> lkFirstLevel;    // candidatos (ganancia, t3) del primer nivel
+    std::vector<int>                exactNodes;      // bodega + clientes ordenados de la ruta exacta
+    std::vector<int>                exactCost;       // tablas Held-Karp para rutas sobre los kernels fijos
+    std::vector<unsigned char>      exactParent;
+
+    static constexpr int LK_FIRST_LEVEL_BREADTH = 3;
+
     Route optimizeRoute(const Route& route);
 
+    void exactOptimize(std::vector<int>& path);
+    bool exactSetKey(const std::vector<int>& path, std::vector<int>& key) const;
+    void threeOpt(std::vector<int>& path) const;
+    void orThreeOpt(std::vector<int>& path) const;
+    void moveSegment(std::vector<int>& path, int i, int e, int k, bool reversed) const;
+    void localSearch(std::vector<int>& path);
+    void buildRouteNeighbors(const std::vector<int>& path);
+    bool improveTwoOpt(std::vector<int>& path, int node);
+    bool improveOrOpt(std::vector<int>& path, int node);
+    bool improveLinKernighan(std::vector<int>& path, int t1, bool forward);
+    int  linKernighanChain(std::vector<int>& path, int t1, bool forward, int firstRank);
+    void updatePositions(const std::vector<int>& path, int from, int to);
+    void activate(int node);
+    void prepareWorkers();
+    const std::vector<int>* findCached(const std::vector<int>& path);
+    void storeCached(const std::vector<int>& input, const std::vector<int>& output);
+
 public:
     explicit KOpt(const Parser* parser);
 
     Solution optimize(const Solution& initialSolution);
 
+    // Cambiar el vecindario invalida las rutas memorizadas
+    void setMode(Mode m) { mode = m; clearCache(); }
+    void setPolicy(Policy p) { policy = p; clearCache(); }
+    void setNeighborListSize(int k) { neighborListSize = k; clearCache(); }
+    void setLinKernighanDepth(int depth) { lkDepth = depth; clearCache(); }
+    void setFinalThreeOpt(bool enabled) { finalThreeOpt = enabled; clearCache(); }
+    void setNumThreads(int threads);
+    void setExactThreshold(int clients);
+
+    void setCacheCapacity(size_t entries);
+    void clearCache();
+    long long getCacheHits() const { return cacheHits; }
+    long long getCacheMisses() const { return cacheMisses; }
+
     ~KOpt();
 };
 
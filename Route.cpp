@@ -13,6 +13,21 @@ Route::Route(int maxCapacity, const Parser* parser)
     path.push_back(1); 
 }
 
+/*
+ * Descripción: Constructor de construcción masiva. Adopta una secuencia completa
+ * (bodega en ambos extremos) y calcula carga y costo en una sola pasada, sin
+ * reinsertar cliente por cliente. No verifica capacidad: isValid() lo reporta.
+ * Entrada: Capacidad máxima del vehículo, puntero al parser, secuencia completa de la ruta.
+ * Salida: Instancia de Route con la secuencia dada.
+ */
+Route::Route(int maxCapacity, const Parser* parser, const std::vector<int>& fullPath)
+    : path(fullPath), currentLoad(0), totalCost(0.0), maxCapacity(maxCapacity), parserData(parser) {
+    for (size_t i = 1; i + 1 < path.size(); ++i) {
+        currentLoad += parserData->getClients()[path[i]].getDemand();
+    }
+    updateMetrics();
+}
+
 /*
  * Descripción: Recalcula el costo total de la ruta iterando sobre todos sus segmentos.
  * Entrada: Ninguna.
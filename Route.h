@@ -22,6 +22,7 @@ private:
 
 public:
     Route(int maxCapacity, const Parser* parser);
+    Route(int maxCapacity, const Parser* parser, const std::vector<int>& fullPath);
 
     bool addClient(int clientId); 
     void insertClientAt(int index, int clientId);
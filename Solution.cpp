@@ -40,6 +40,31 @@ void Solution::addRoute(const Route& route) {
     calculateTotalCost(); 
 }
 
+/*
+ * Descripción: Sustituye in-place una ruta existente y ajusta el costo global de forma
+ * incremental (sin recorrer el resto de la flota).
+ * Entrada: Índice de la ruta a reemplazar, nueva ruta.
+ * Salida: Ninguna.
+ */
+void Solution::replaceRoute(int index, const Route& route) {
+    totalCost += route.getTotalCost() - routes[index].getTotalCost();
+    routes[index] = route;
+}
+
+/*
+ * Descripción: Elimina las rutas que quedaron sin clientes tras un movimiento in-place.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void Solution::removeEmptyRoutes() {
+    vector<Route> kept;
+    for (const auto& route : routes) {
+        if (route.getPath().size() > 2) kept.push_back(route);
+    }
+    routes.swap(kept);
+    calculateTotalCost();
+}
+
 /*
  * Descripción: Valida la factibilidad estructural de toda la solución. Verifica que todas
  * las rutas sean válidas individualmente y que cada cliente sea visitado exactamente una vez.
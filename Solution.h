@@ -24,6 +24,8 @@ public:
     explicit Solution(const Parser* parser);
 
     void addRoute(const Route& route);
+    void replaceRoute(int index, const Route& route);
+    void removeEmptyRoutes();
     
     bool isValid() const;
 
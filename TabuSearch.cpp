@@ -0,0 +1,356 @@
+#include "TabuSearch.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+using chrono::duration;
+
+/*
+ * Descripción: Constructor de la búsqueda tabú granular.
+ * Entrada: Puntero constante al parser con los datos de la instancia.
+ * Salida: Instancia inicializada.
+ */
+TabuSearch::TabuSearch(const Parser* parser) : parserData(parser), rng(42) {}
+
+// ─────────────────────────────────────────────────────────────
+// Estructuras de la Búsqueda
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Construye las listas de aristas candidatas: para cada cliente, los clientes a
+ * distancia a lo más beta * costo / (clientes + vehículos), con un mínimo de MIN_CANDIDATES
+ * y un máximo de MAX_CANDIDATES (la lista ordenada de vecinos permite cortar en O(k)).
+ * Entrada: Factor beta, costo de referencia, número de vehículos.
+ * Salida: Ninguna (actualiza candidateNeighbors).
+ */
+void TabuSearch::buildCandidateLists(double beta, double referenceCost, int numRoutes) {
+    int dimension = parserData->getDimension();
+    double threshold = beta * referenceCost / (dimension - 1 + numRoutes);
+
+    candidateNeighbors.assign(dimension + 1, vector<int>());
+    for (int u = 2; u <= dimension; u++) {
+        for (const Neighbor& neighbor : parserData->getSortedNeighbors(u)) {
+            if (neighbor.id == 1) continue;
+            int count = candidateNeighbors[u].size();
+            if (count == MAX_CANDIDATES || (count >= MIN_CANDIDATES && neighbor.distance > threshold)) break;
+            candidateNeighbors[u].push_back(neighbor.id);
+        }
+    }
+}
+
+/*
+ * Descripción: Copia las rutas de la solución a la representación de trabajo, reinicia la
+ * memoria tabú y reserva una ruta vacía para abrir vehículos.
+ * Entrada: Solución de trabajo (puede recibir la ruta de reserva).
+ * Salida: Ninguna.
+ */
+void TabuSearch::loadSolution(Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int numRoutes = routes.size();
+
+    paths.assign(numRoutes, vector<int>());
+    prefixLoad.assign(numRoutes, vector<int>());
+    routeOf.assign(parserData->getDimension() + 1, -1);
+    posOf.assign(parserData->getDimension() + 1, -1);
+    tabuUntil.assign((size_t)numRoutes * (parserData->getDimension() + 1), 0);
+
+    for (int r = 0; r < numRoutes; r++) {
+        paths[r] = routes[r].getPath();
+        refreshRoute(r);
+    }
+    spareRoute = -1;
+    updateSpareRoute(sol);
+}
+
+/*
+ * Descripción: Recalcula la carga acumulada y las posiciones de los clientes de una ruta
+ * (se invoca sólo para las rutas que modificó el movimiento).
+ * Entrada: Índice de la ruta.
+ * Salida: Ninguna.
+ */
+void TabuSearch::refreshRoute(int route) {
+    const vector<int>& path = paths[route];
+    vector<int>& prefix = prefixLoad[route];
+    prefix.assign(path.size(), 0);
+    for (int i = 1; i < (int)path.size(); i++) {
+        prefix[i] = prefix[i - 1] + (i + 1 < (int)path.size() ? parserData->getClients()[path[i]].getDemand() : 0);
+        if (i + 1 < (int)path.size()) {
+            routeOf[path[i]] = route;
+            posOf[path[i]]   = i;
+        }
+    }
+}
+
+/*
+ * Descripción: Garantiza que haya una ruta vacía de reserva. Las rutas vaciadas conservan
+ * su índice (así la memoria tabú sigue siendo válida) y se reutilizan como reserva; si no
+ * queda ninguna, se agrega una al final.
+ * Entrada: Solución de trabajo.
+ * Salida: Ninguna.
+ */
+void TabuSearch::updateSpareRoute(Solution& sol) {
+    if (spareRoute != -1 && paths[spareRoute].size() <= 2) return;
+
+    for (int r = 0; r < (int)paths.size(); r++) {
+        if (paths[r].size() <= 2) { spareRoute = r; return; }
+    }
+
+    spareRoute = paths.size();
+    paths.push_back({ 1, 1 });
+    prefixLoad.push_back({ 0, 0 });
+    tabuUntil.resize(paths.size() * (parserData->getDimension() + 1), 0);
+    sol.addRoute(Route(parserData->getCapacity(), parserData));
+}
+
+/*
+ * Descripción: Indica si el atributo (cliente, ruta) está prohibido: el cliente salió de esa
+ * ruta hace menos iteraciones que su permanencia tabú.
+ * Entrada: Cliente, ruta de destino.
+ * Salida: Booleano.
+ */
+bool TabuSearch::isTabu(int client, int route) const {
+    return tabuUntil[(size_t)route * (parserData->getDimension() + 1) + client] > iteration;
+}
+
+/*
+ * Descripción: Prohíbe que el cliente vuelva a la ruta durante una permanencia aleatoria
+ * en [tenureMin, tenureMax].
+ * Entrada: Cliente, ruta que abandona.
+ * Salida: Ninguna.
+ */
+void TabuSearch::makeTabu(int client, int route) {
+    int tenure = uniform_int_distribution<int>(tenureMin, tenureMax)(rng);
+    tabuUntil[(size_t)route * (parserData->getDimension() + 1) + client] = iteration + tenure;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Evaluación y Aplicación de Movimientos
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Compara un movimiento con el mejor admisible hasta ahora. Un movimiento tabú
+ * sólo es admisible si lleva a una solución mejor que la mejor conocida (aspiración).
+ * Entrada: Movimiento, si es tabú, costo actual, mejor costo conocido, mejor movimiento.
+ * Salida: Ninguna (actualiza 'best').
+ */
+void TabuSearch::consider(const Move& move, bool tabu, double currentCost, double bestCost, Move& best) const {
+    if (tabu && currentCost + move.delta >= bestCost - 1e-9) return;
+    if (best.type == NoMove || move.delta < best.delta) best = move;
+}
+
+/*
+ * Descripción: Evalúa en O(1) cada movimiento que crea una arista candidata (u, v):
+ *  - Relocate: u pasa antes o después de v (o sola a la ruta de reserva).
+ *  - Swap: u se intercambia con el predecesor o el sucesor de v.
+ *  - 2-OPT*: intercambio de colas tras u y v, directo o invertido.
+ *  - 2-OPT intra-ruta (u y v en la misma ruta), sólo si mejora: no cambia atributos tabú.
+ * Entrada: Cliente u, costo actual, mejor costo conocido, mejor movimiento.
+ * Salida: Ninguna (actualiza 'best').
+ */
+void TabuSearch::evaluateMoves(int u, double currentCost, double bestCost, Move& best) const {
+    const auto& clients = parserData->getClients();
+    int Q  = parserData->getCapacity();
+    int r1 = routeOf[u], i = posOf[u];
+    const vector<int>& path1 = paths[r1];
+    int prevU = path1[i - 1], nextU = path1[i + 1];
+    int demU  = clients[u].getDemand();
+    int load1 = prefixLoad[r1].back();
+    int removal = distance(prevU, nextU) - distance(prevU, u) - distance(u, nextU);
+
+    if (path1.size() > 3 && spareRoute != -1) {
+        Move open = { RelocateMove, removal + 2 * distance(1, u), r1, i, spareRoute, 1 };
+        consider(open, isTabu(u, spareRoute), currentCost, bestCost, best);
+    }
+
+    for (int v : candidateNeighbors[u]) {
+        int r2 = routeOf[v], j = posOf[v];
+        const vector<int>& path2 = paths[r2];
+
+        if (r2 == r1) {
+            int a = min(i, j), b = max(i, j);
+            if (b == a + 1) continue;
+            int delta = distance(path1[a], path1[b]) + distance(path1[a + 1], path1[b + 1])
+                      - distance(path1[a], path1[a + 1]) - distance(path1[b], path1[b + 1]);
+            if (delta < 0) consider({ IntraTwoOpt, delta, r1, a, r1, b }, false, currentCost, bestCost, best);
+            continue;
+        }
+
+        int load2 = prefixLoad[r2].back();
+        bool tabuInR2 = isTabu(u, r2);
+
+        // Relocate: u antes o después de v
+        if (load2 + demU <= Q) {
+            int after  = removal + distance(v, u) + distance(u, path2[j + 1]) - distance(v, path2[j + 1]);
+            int before = removal + distance(path2[j - 1], u) + distance(u, v) - distance(path2[j - 1], v);
+            consider({ RelocateMove, after, r1, i, r2, j + 1 }, tabuInR2, currentCost, bestCost, best);
+            consider({ RelocateMove, before, r1, i, r2, j }, tabuInR2, currentCost, bestCost, best);
+        }
+
+        // Swap: u ocupa el lugar del predecesor o del sucesor de v, quedando junto a v
+        for (int k : { j - 1, j + 1 }) {
+            if (k < 1 || k > (int)path2.size() - 2) continue;
+            int w = path2[k];
+            int demW = clients[w].getDemand();
+            if (load1 - demU + demW > Q || load2 - demW + demU > Q) continue;
+
+            int delta = distance(prevU, w) + distance(w, nextU) - distance(prevU, u) - distance(u, nextU)
+                      + distance(path2[k - 1], u) + distance(u, path2[k + 1])
+                      - distance(path2[k - 1], w) - distance(w, path2[k + 1]);
+            consider({ SwapMove, delta, r1, i, r2, k }, tabuInR2 || isTabu(w, r1), currentCost, bestCost, best);
+        }
+
+        // 2-OPT*: x e y son los sucesores de u y v
+        int x = nextU, y = path2[j + 1];
+        int headA = prefixLoad[r1][i], headB = prefixLoad[r2][j];
+        int removed = distance(u, x) + distance(v, y);
+
+        if ((x != 1 || y != 1) && headA + load2 - headB <= Q && headB + load1 - headA <= Q) {
+            int delta = distance(u, y) + distance(v, x) - removed;
+            bool tabu = (x != 1 && isTabu(x, r2)) || (y != 1 && isTabu(y, r1));
+            consider({ TailExchange, delta, r1, i, r2, j }, tabu, currentCost, bestCost, best);
+        }
+        if (headA + headB <= Q && (load1 - headA) + (load2 - headB) <= Q) {
+            int delta = distance(u, v) + distance(x, y) - removed;
+            bool tabu = isTabu(v, r1) || (x != 1 && isTabu(x, r2));
+            consider({ TailExchangeReversed, delta, r1, i, r2, j }, tabu, currentCost, bestCost, best);
+        }
+    }
+}
+
+/*
+ * Descripción: Reemplaza una ruta en la solución y en la representación de trabajo.
+ * Entrada: Solución de trabajo, índice de la ruta, nueva secuencia.
+ * Salida: Ninguna.
+ */
+void TabuSearch::replacePath(Solution& sol, int route, const vector<int>& path) {
+    paths[route] = path;
+    sol.replaceRoute(route, Route(parserData->getCapacity(), parserData, path));
+    refreshRoute(route);
+}
+
+/*
+ * Descripción: Aplica un movimiento sobre la solución (sólo se reconstruyen las rutas
+ * involucradas) y declara tabú el regreso de cada cliente a la ruta que abandonó.
+ * Entrada: Movimiento, solución de trabajo.
+ * Salida: Ninguna.
+ */
+void TabuSearch::applyMove(const Move& move, Solution& sol) {
+    vector<int> pathA = paths[move.r1];
+    vector<int> pathB = paths[move.r2];
+    int i = move.i, j = move.j;
+
+    switch (move.type) {
+        case RelocateMove: {
+            int u = pathA[i];
+            pathA.erase(pathA.begin() + i);
+            pathB.insert(pathB.begin() + j, u);
+            makeTabu(u, move.r1);
+            break;
+        }
+        case SwapMove:
+            makeTabu(pathA[i], move.r1);
+            makeTabu(pathB[j], move.r2);
+            swap(pathA[i], pathB[j]);
+            break;
+        case TailExchange: {
+            for (int k = i + 1; k < (int)pathA.size() - 1; k++) makeTabu(pathA[k], move.r1);
+            for (int k = j + 1; k < (int)pathB.size() - 1; k++) makeTabu(pathB[k], move.r2);
+            vector<int> newA(pathA.begin(), pathA.begin() + i + 1);
+            newA.insert(newA.end(), pathB.begin() + j + 1, pathB.end());
+            vector<int> newB(pathB.begin(), pathB.begin() + j + 1);
+            newB.insert(newB.end(), pathA.begin() + i + 1, pathA.end());
+            pathA.swap(newA);
+            pathB.swap(newB);
+            break;
+        }
+        case TailExchangeReversed: {
+            for (int k = i + 1; k < (int)pathA.size() - 1; k++) makeTabu(pathA[k], move.r1);
+            for (int k = 1; k <= j; k++) makeTabu(pathB[k], move.r2);
+            vector<int> newA(pathA.begin(), pathA.begin() + i + 1);
+            newA.insert(newA.end(), pathB.rend() - j - 1, pathB.rend() - 1);
+            newA.push_back(1);
+            vector<int> newB = { 1 };
+            newB.insert(newB.end(), pathA.rbegin() + 1, pathA.rend() - i - 1);
+            newB.insert(newB.end(), pathB.begin() + j + 1, pathB.end());
+            pathA.swap(newA);
+            pathB.swap(newB);
+            break;
+        }
+        case IntraTwoOpt:
+            reverse(pathA.begin() + i + 1, pathA.begin() + j + 1);
+            break;
+        default:
+            return;
+    }
+
+    replacePath(sol, move.r1, pathA);
+    if (move.r2 != move.r1) replacePath(sol, move.r2, pathB);
+    updateSpareRoute(sol);
+}
+
+// ─────────────────────────────────────────────────────────────
+// Ciclo Principal
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Bucle principal de la búsqueda tabú. En cada iteración aplica el mejor
+ * movimiento admisible del vecindario granular. Tras STAGNATION_FACTOR * n iteraciones sin
+ * mejorar la mejor solución, reinicia desde ella alternando entre el umbral de granularidad
+ * normal y uno ampliado en DIVERSIFY_FACTOR.
+ * Entrada: Solución factible inicial, límite de tiempo en segundos (0 = sólo setMaxIterations).
+ * Salida: La mejor solución encontrada.
+ */
+Solution TabuSearch::optimize(const Solution& initialSol, double timeLimitSeconds) {
+    Clock::time_point startTime = Clock::now();
+    Clock::time_point deadline  = timeLimitSeconds > 0.0
+        ? startTime + chrono::duration_cast<Clock::duration>(duration<double>(timeLimitSeconds))
+        : Clock::time_point::max();
+
+    Solution best    = initialSol;
+    Solution current = initialSol;
+    current.removeEmptyRoutes();
+    int numRoutes  = current.getRoutes().size();
+    int numClients = parserData->getDimension() - 1;
+
+    loadSolution(current);
+    buildCandidateLists(granularityBeta, current.getTotalCost(), numRoutes);
+
+    cout << "[TABU] Inicio | Costo: " << initialSol.getTotalCost()
+         << " | beta=" << granularityBeta << " tenencia=[" << tenureMin << ", " << tenureMax << "]" << endl;
+
+    iteration = 0;
+    long long lastImprovement = 0;
+    long long stagnationLimit = (long long)STAGNATION_FACTOR * numClients;
+    bool      diversifying    = false;
+
+    while (Clock::now() < deadline && (maxIterations == 0 || iteration < maxIterations)) {
+        iteration++;
+
+        Move move;
+        double currentCost = current.getTotalCost();
+        double bestCost    = best.getTotalCost();
+        for (int u = 2; u <= parserData->getDimension(); u++) evaluateMoves(u, currentCost, bestCost, move);
+        applyMove(move, current);
+
+        if (current.getTotalCost() < bestCost - 1e-9) {
+            best = current;
+            lastImprovement = iteration;
+        } else if (iteration - lastImprovement >= stagnationLimit) {
+            diversifying = !diversifying;
+            current = best;
+            current.removeEmptyRoutes();
+            loadSolution(current);
+            buildCandidateLists(diversifying ? granularityBeta * DIVERSIFY_FACTOR : granularityBeta,
+                                best.getTotalCost(), current.getRoutes().size());
+            lastImprovement = iteration;
+        }
+    }
+
+    best.removeEmptyRoutes();
+    double elapsed = duration<double>(Clock::now() - startTime).count();
+    cout << "[TABU] Fin | Iteraciones: " << iteration
+         << " | Mejor costo: " << best.getTotalCost()
+         << " | Tiempo: " << elapsed << "s" << endl;
+
+    return best;
+}
\ No newline at end of file
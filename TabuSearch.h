@@ -0,0 +1,89 @@
+#ifndef TABU_SEARCH_H
+#define TABU_SEARCH_H
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include "Parser.h"
+#include "Solution.h"
+#include "Route.h"
+
+/*
+ * Clase TabuSearch
+ * Descripción: Implementa una búsqueda tabú granular (estilo Toth-Vigo) para el CVRP. Sólo
+ * se evalúan movimientos que crean una arista candidata, es decir, de largo a lo más
+ * beta * costo / (clientes + vehículos). En cada iteración aplica el mejor movimiento
+ * admisible (Relocate, Swap, 2-OPT* o 2-OPT intra-ruta), aunque empeore la solución. Al
+ * sacar un cliente de una ruta, el atributo (cliente, ruta) queda tabú unas iteraciones, y
+ * un movimiento tabú sólo se acepta si mejora la mejor solución conocida (aspiración). Con
+ * la misma semilla y un límite de iteraciones el resultado es determinista.
+ */
+class TabuSearch {
+public:
+    explicit TabuSearch(const Parser* parser);
+
+    Solution optimize(const Solution& initialSol, double timeLimitSeconds);
+
+    void setGranularity(double beta) { granularityBeta = beta; }
+    void setTabuTenure(int minIterations, int maxIterations) { tenureMin = minIterations; tenureMax = maxIterations; }
+    void setMaxIterations(long long iterations) { maxIterations = iterations; }
+    void setSeed(unsigned int seed) { rng.seed(seed); }
+
+    long long getIterations() const { return iteration; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    enum MoveType { NoMove, RelocateMove, SwapMove, TailExchange, TailExchangeReversed, IntraTwoOpt };
+
+    /*
+     * Estructura Move
+     * Descripción: Movimiento candidato: rutas y posiciones involucradas y variación del costo.
+     */
+    struct Move {
+        MoveType type  = NoMove;
+        int      delta = 0;
+        int      r1 = -1, i = -1;     // ruta y posición del cliente u
+        int      r2 = -1, j = -1;     // ruta y posición de destino / del otro cliente
+    };
+
+    const Parser* parserData;
+    std::mt19937  rng;
+
+    double    granularityBeta = 1.5;
+    int       tenureMin       = 10;
+    int       tenureMax       = 20;
+    long long maxIterations   = 0;      // 0 = sólo límite de tiempo
+    long long iteration       = 0;
+
+    static constexpr int    MIN_CANDIDATES     = 3;      // aristas candidatas por cliente como mínimo
+    static constexpr int    MAX_CANDIDATES     = 40;     // aristas candidatas por cliente como máximo
+    static constexpr int    STAGNATION_FACTOR  = 20;     // iteraciones sin mejora por cliente antes de reiniciar
+    static constexpr double DIVERSIFY_FACTOR   = 2.0;    // beta se multiplica por esto tras un reinicio
+
+    // ── Estado de la búsqueda ─────────────────────────────────
+    std::vector<std::vector<int>> candidateNeighbors;   // clientes a distancia <= umbral (sin la bodega)
+    std::vector<std::vector<int>> paths;                // copia de trabajo de las rutas
+    std::vector<std::vector<int>> prefixLoad;           // carga acumulada de cada ruta hasta cada posición
+    std::vector<int>              routeOf;              // ruta de cada cliente
+    std::vector<int>              posOf;                // posición de cada cliente en su ruta
+    std::vector<long long>        tabuUntil;            // índice ruta * (dimensión + 1) + cliente
+    int                           spareRoute = -1;      // ruta vacía disponible para abrir un vehículo
+
+    void buildCandidateLists(double beta, double referenceCost, int numRoutes);
+    void loadSolution(Solution& sol);
+    void refreshRoute(int route);
+    void updateSpareRoute(Solution& sol);
+
+    bool isTabu(int client, int route) const;
+    void makeTabu(int client, int route);
+
+    void evaluateMoves(int client, double currentCost, double bestCost, Move& best) const;
+    void consider(const Move& move, bool tabu, double currentCost, double bestCost, Move& best) const;
+    void applyMove(const Move& move, Solution& sol);
+    void replacePath(Solution& sol, int route, const std::vector<int>& path);
+
+    int distance(int a, int b) const { return parserData->getDistance(a, b); }
+};
+
+#endif // TABU_SEARCH_H
\ No newline at end of file
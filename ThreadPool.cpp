@@ -0,0 +1,87 @@
+#include "ThreadPool.h"
+
+using namespace std;
+
+/*
+ * Descripción: Crea el pool. El hilo que llama a run() también trabaja, por lo que
+ * se lanzan numThreads-1 hilos adicionales.
+ * Entrada: Número total de hilos a utilizar (mínimo 1).
+ * Salida: Instancia con los hilos esperando trabajo.
+ */
+ThreadPool::ThreadPool(int numThreads) {
+    for (int w = 1; w < numThreads; ++w) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, w);
+    }
+}
+
+/*
+ * Descripción: Ejecuta fn sobre todas las tareas del lote y bloquea hasta que terminan.
+ * Entrada: Número de tareas y función a aplicar sobre (tarea, trabajador).
+ * Salida: Ninguna.
+ */
+void ThreadPool::run(int numTasks, const function<void(int, int)>& fn) {
+    if (numTasks <= 0) return;
+
+    {
+        lock_guard<mutex> lock(mtx);
+        job         = &fn;
+        jobTasks    = numTasks;
+        nextTask.store(0);
+        busyWorkers = (int)workers.size();
+        ++generation;
+    }
+    startCv.notify_all();
+
+    drain(0);
+
+    unique_lock<mutex> lock(mtx);
+    doneCv.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+/*
+ * Descripción: Reclama y ejecuta tareas del lote actual hasta agotarlo.
+ * Entrada: Índice del trabajador.
+ * Salida: Ninguna.
+ */
+void ThreadPool::drain(int workerId) {
+    while (true) {
+        int task = nextTask.fetch_add(1);
+        if (task >= jobTasks) break;
+        (*job)(task, workerId);
+    }
+}
+
+/*
+ * Descripción: Bucle de cada hilo trabajador: espera un nuevo lote, lo procesa y avisa.
+ * Entrada: Índice del trabajador.
+ * Salida: Ninguna.
+ */
+void ThreadPool::workerLoop(int workerId) {
+    int seenGeneration = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(mtx);
+            startCv.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        drain(workerId);
+
+        {
+            lock_guard<mutex> lock(mtx);
+            --busyWorkers;
+        }
+        doneCv.notify_one();
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(mtx);
+        stopping = true;
+    }
+    startCv.notify_all();
+    for (auto& t : workers) t.join();
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+/*
+ * Clase ThreadPool
+ * Descripción: Conjunto fijo de hilos trabajadores reutilizados entre llamadas.
+ * Cada llamada a run() reparte un lote de tareas indexadas 0..numTasks-1: los hilos
+ * (incluido el que llama) reclaman la siguiente tarea libre de un contador atómico,
+ * de modo que quien termina antes toma más trabajo. Si el llamador ordena las tareas
+ * de mayor a menor costo, el reparto queda balanceado.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads);
+
+    // fn(tarea, trabajador): el índice de trabajador está en [0, size())
+    void run(int numTasks, const std::function<void(int, int)>& fn);
+
+    int size() const { return (int)workers.size() + 1; }
+
+    ~ThreadPool();
+
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex              mtx;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+
+    const std::function<void(int, int)>* job = nullptr;
+    int               jobTasks    = 0;
+    std::atomic<int>  nextTask{0};
+    int               generation  = 0;
+    int               busyWorkers = 0;
+    bool              stopping    = false;
+
+    void workerLoop(int workerId);
+    void drain(int workerId);
+};
+
+#endif // THREADPOOL_H
\ No newline at end of file
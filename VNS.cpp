@@ -3,8 +3,9 @@
 #include <limits>
 #include <algorithm>
 #include <iostream>
-#include <map>
 #include <climits>
+#include <cmath>
+#include <mutex>
 
 using namespace std;
 
@@ -13,7 +14,18 @@ using namespace std;
  * Entrada: Puntero constante al parser con los datos de la instancia.
  * Salida: Instancia inicializada.
  */
-VNS::VNS(const Parser* parser) : parserData(parser) {}
+VNS::VNS(const Parser* parser) : parserData(parser), kopt(parser), loadLimit(parser->getCapacity()) {
+    // Las rutas cortas (mayoría en instancias con muchos vehículos) se resuelven de forma exacta
+    kopt.setExactThreshold(8);
+
+    // Ángulo polar de cada cliente alrededor de la bodega, discretizado en [0, 65536)
+    const auto& clients = parser->getClients();
+    polarAngle.assign(parser->getDimension() + 1, 0);
+    for (int c = 2; c <= parser->getDimension(); c++) {
+        double angle = atan2(clients[c].getY() - clients[1].getY(), clients[c].getX() - clients[1].getX());
+        polarAngle[c] = CircleSector::positiveMod((int)(32768.0 * angle / M_PI));
+    }
+}
 
 // ─────────────────────────────────────────────────────────────
 // Métodos Auxiliares de Costo
@@ -43,110 +55,570 @@ int VNS::removalSaving(int prev, int clientId, int next) const {
          - parserData->getDistance(clientId, next);
 }
 
-// ─────────────────────────────────────────────────────────────
-// Estructuras de Vecindad
-// ─────────────────────────────────────────────────────────────
+/*
+ * Descripción: Registra la ruta y la posición de cada cliente de la solución, para que las
+ * vecindades granulares ubiquen en O(1) a los vecinos cercanos de un cliente.
+ * Entrada: Solución actual.
+ * Salida: Ninguna (actualiza routeOf y posOf).
+ */
+void VNS::buildLocationMap(const Solution& sol) {
+    routeOf.assign(parserData->getDimension() + 1, -1);
+    posOf.assign(parserData->getDimension() + 1, -1);
+    const auto& routes = sol.getRoutes();
+    for (int r = 0; r < (int)routes.size(); r++) {
+        const vector<int>& path = routes[r].getPath();
+        for (int i = 1; i < (int)path.size() - 1; i++) {
+            routeOf[path[i]] = r;
+            posOf[path[i]]   = i;
+        }
+    }
+}
 
 /*
- * Descripción: Explora la vecindad "Relocate". Evalúa mover un cliente de su ruta actual 
- * a la mejor posición posible dentro de cualquier otra ruta distinta. 
- * Aplica el mejor movimiento encontrado (Best-Improvement) que respete las capacidades.
- * Entrada: Solución actual por referencia.
- * Salida: Booleano indicando si se aplicó un movimiento que mejora estrictamente el costo.
+ * Descripción: Calcula la carga acumulada de cada ruta hasta cada posición, para obtener en
+ * O(1) la carga de cualquier segmento o cola de ruta.
+ * Entrada: Solución actual.
+ * Salida: Ninguna (actualiza prefixLoad).
  */
-bool VNS::neighborhoodRelocate(Solution& sol) {
+void VNS::buildPrefixLoads(const Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    prefixLoad.resize(routes.size());
+    for (int r = 0; r < (int)routes.size(); r++) {
+        const vector<int>& path = routes[r].getPath();
+        int last = path.size() - 1;
+        prefixLoad[r].assign(path.size(), 0);
+        for (int i = 1; i < last; i++)
+            prefixLoad[r][i] = prefixLoad[r][i - 1] + parserData->getClients()[path[i]].getDemand();
+        prefixLoad[r][last] = prefixLoad[r][last - 1];
+    }
+}
+
+/*
+ * Descripción: Número de vecinos cercanos que usan las vecindades que siempre son granulares
+ * (2-OPT* y CROSS): la granularidad configurada o, en modo exhaustivo, un valor por defecto.
+ * Entrada: Ninguna.
+ * Salida: Número de vecinos.
+ */
+int VNS::neighborListSize() const {
+    return granularity > 0 ? granularity : DEFAULT_GRANULARITY;
+}
+
+/*
+ * Descripción: Genera las posiciones (ruta, índice) donde evaluar, en modo granular, la
+ * inserción de un segmento [first..last] fuera de su ruta: sólo aquellas que crean una
+ * arista (v, first) o (last, v) con v entre los 'granularity' vecinos más cercanos. Si la
+ * bodega es vecina cercana se consideran el inicio o el final de cada ruta.
+ * Entrada: Solución actual, extremos del segmento, ruta de origen (excluida).
+ * Salida: Ninguna (llena 'candidates').
+ */
+void VNS::insertionCandidates(const Solution& sol, int first, int last, int excludedRoute) {
     const auto& routes = sol.getRoutes();
     int numRoutes = routes.size();
-    int Q = parserData->getCapacity();
+    candidates.clear();
+
+    const auto& firstNeighbors = parserData->getSortedNeighbors(first);
+    int limit = min(granularity, (int)firstNeighbors.size());
+    for (int k = 0; k < limit; k++) {
+        int v = firstNeighbors[k].id;
+        if (v == 1) {
+            for (int r = 0; r < numRoutes; r++)
+                if (r != excludedRoute) candidates.push_back({r, 1});
+        } else if (routeOf[v] != excludedRoute && routeOf[v] != -1) {
+            candidates.push_back({routeOf[v], posOf[v] + 1});
+        }
+    }
 
-    int bestDelta     = 0;   
-    int bestFromRoute = -1;
-    int bestFromPos   = -1;  
-    int bestToRoute   = -1;
-    int bestToPos     = -1;  
+    const auto& lastNeighbors = parserData->getSortedNeighbors(last);
+    limit = min(granularity, (int)lastNeighbors.size());
+    for (int k = 0; k < limit; k++) {
+        int v = lastNeighbors[k].id;
+        if (v == 1) {
+            for (int r = 0; r < numRoutes; r++)
+                if (r != excludedRoute) candidates.push_back({r, (int)routes[r].getPath().size() - 1});
+        } else if (routeOf[v] != excludedRoute && routeOf[v] != -1) {
+            candidates.push_back({routeOf[v], posOf[v]});
+        }
+    }
+}
 
-    for (int r1 = 0; r1 < numRoutes; r1++) {
-        const vector<int>& path1 = routes[r1].getPath();
-        int clientsInRoute = path1.size() - 2;
-        if (clientsInRoute <= 1) continue; 
+/*
+ * Descripción: Genera los clientes (ruta, índice) con los que evaluar, en modo granular, el
+ * intercambio de 'client': el predecesor y el sucesor de cada vecino cercano de otra ruta,
+ * de modo que 'client' quede adyacente a ese vecino tras el intercambio.
+ * Entrada: Solución actual, cliente, ruta del cliente.
+ * Salida: Ninguna (llena 'candidates').
+ */
+void VNS::swapCandidates(const Solution& sol, int client, int clientRoute) {
+    const auto& routes = sol.getRoutes();
+    candidates.clear();
+
+    const auto& neighbors = parserData->getSortedNeighbors(client);
+    int limit = min(granularity, (int)neighbors.size());
+    for (int k = 0; k < limit; k++) {
+        int v = neighbors[k].id;
+        if (v == 1 || routeOf[v] == clientRoute || routeOf[v] == -1) continue;
+
+        int r = routeOf[v], p = posOf[v];
+        int clients = routes[r].getPath().size() - 2;
+        if (p - 1 >= 1)       candidates.push_back({r, p - 1});
+        if (p + 1 <= clients) candidates.push_back({r, p + 1});
+    }
+}
 
-        for (int i = 1; i <= clientsInRoute; i++) {
-            int client = path1[i];
-            int prev1  = path1[i - 1];
-            int next1  = path1[i + 1];
-            int demand = parserData->getClients()[client].getDemand();
+/*
+ * Descripción: Costo de mover el segmento path1[i..i+segLen-1] entre path2[j-1] y path2[j]
+ * (ahorro de extraerlo más costo de insertarlo).
+ * Entrada: Ruta origen, inicio y largo del segmento, ruta destino, posición de inserción.
+ * Salida: Variación del costo total (negativa si mejora).
+ */
+int VNS::segmentMoveDelta(const vector<int>& path1, int i, int segLen,
+                          const vector<int>& path2, int j) const {
+    int prevSeg  = path1[i - 1];
+    int nextSeg  = path1[i + segLen];
+    int segFirst = path1[i];
+    int segLast  = path1[i + segLen - 1];
+
+    return parserData->getDistance(prevSeg, nextSeg)
+         - parserData->getDistance(prevSeg, segFirst)
+         - parserData->getDistance(segLast, nextSeg)
+         + parserData->getDistance(path2[j - 1], segFirst)
+         + parserData->getDistance(segLast, path2[j])
+         - parserData->getDistance(path2[j - 1], path2[j]);
+}
 
-            int saving = removalSaving(prev1, client, next1);
+/*
+ * Descripción: Costo de intercambiar el cliente path1[i] con el cliente path2[j].
+ * Entrada: Ruta del primer cliente y su posición, ruta del segundo cliente y su posición.
+ * Salida: Variación del costo total (negativa si mejora).
+ */
+int VNS::swapDelta(const vector<int>& path1, int i, const vector<int>& path2, int j) const {
+    int c1 = path1[i], prev1 = path1[i - 1], next1 = path1[i + 1];
+    int c2 = path2[j], prev2 = path2[j - 1], next2 = path2[j + 1];
+
+    return parserData->getDistance(prev1, c2) +
+           parserData->getDistance(c2, next1) -
+           parserData->getDistance(prev1, c1) -
+           parserData->getDistance(c1, next1) +
+           parserData->getDistance(prev2, c1) +
+           parserData->getDistance(c1, next2) -
+           parserData->getDistance(prev2, c2) -
+           parserData->getDistance(c2, next2);
+}
 
-            for (int r2 = 0; r2 < numRoutes; r2++) {
-                if (r1 == r2) continue;
-                if (routes[r2].getCurrentLoad() + demand > Q) continue;
+// ─────────────────────────────────────────────────────────────
+// Caché de Movimientos por Par de Rutas
+// ─────────────────────────────────────────────────────────────
 
-                const vector<int>& path2 = routes[r2].getPath();
-                int positions = path2.size() - 1; 
+/*
+ * Descripción: Compara cada ruta con la instantánea de la llamada anterior y marca con el
+ * reloj actual (whenLastModified) las que cambiaron, ya sea por un movimiento, por el 3-OPT
+ * o por una agitación. Si cambia el número de rutas se invalida toda la caché.
+ * Entrada: Solución actual.
+ * Salida: Ninguna.
+ */
+void VNS::syncModifications(const Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int numRoutes = routes.size();
+
+    if ((int)routeSnapshot.size() != numRoutes) {
+        routeSnapshot.assign(numRoutes, vector<int>());
+        routeSectors.assign(numRoutes, CircleSector());
+        lastModified.assign(numRoutes, 0);
+        for (auto& cache : pairCache) cache.assign(numRoutes * numRoutes, PairMove());
+        insertionCache.assign((size_t)numRoutes * (parserData->getDimension() + 1), InsertionTop3());
+    }
 
-                for (int j = 1; j <= positions; j++) {
-                    int prevJ = path2[j - 1];
-                    int nextJ = path2[j];
+    for (int r = 0; r < numRoutes; r++) {
+        if (routes[r].getPath() != routeSnapshot[r]) {
+            routeSnapshot[r]  = routes[r].getPath();
+            lastModified[r]   = ++moveClock;
+            updateRouteSector(r, routeSnapshot[r]);
+        }
+    }
+}
 
-                    int cost  = insertionCost(prevJ, client, nextJ);
-                    int delta = cost + saving; 
+/*
+ * Descripción: Indica si el mejor movimiento memorizado para el par (r1, r2) sigue vigente,
+ * es decir, si ninguna de las dos rutas cambió desde que se evaluó.
+ * Entrada: Movimiento memorizado, índices de las rutas.
+ * Salida: Booleano.
+ */
+bool VNS::isPairCurrent(const PairMove& move, int r1, int r2) const {
+    return move.evaluatedAt >= max(lastModified[r1], lastModified[r2]);
+}
 
-                    if (delta < bestDelta) {
-                        bestDelta     = delta;
-                        bestFromRoute = r1;
-                        bestFromPos   = i;
-                        bestToRoute   = r2;
-                        bestToPos     = j;
-                    }
-                }
+/*
+ * Descripción: Evalúa todos los movimientos de un segmento de largo 'segLen' desde la ruta r1
+ * hacia la ruta r2 y memoriza el mejor que respete la capacidad.
+ * Entrada: Solución, largo del segmento, rutas origen y destino, entrada de la caché.
+ * Salida: Ninguna (actualiza 'move').
+ */
+void VNS::evaluateSegmentPair(const Solution& sol, int segLen, int r1, int r2, PairMove& move) const {
+    const auto& routes = sol.getRoutes();
+    const vector<int>& path1 = routes[r1].getPath();
+    const vector<int>& path2 = routes[r2].getPath();
+    int clients1  = path1.size() - 2;
+    int positions = path2.size() - 1;
+    int load1 = routes[r1].getCurrentLoad();
+    int load2 = routes[r2].getCurrentLoad();
+
+    move = PairMove();
+    move.evaluatedAt = moveClock;
+    if (clients1 <= segLen) return;
+
+    for (int i = 1; i <= clients1 - segLen + 1; i++) {
+        int segDemand = 0;
+        for (int s = 0; s < segLen; s++)
+            segDemand += parserData->getClients()[path1[i + s]].getDemand();
+        if (load2 + segDemand > loadLimit) continue;
+
+        int penalty = loadPenaltyDelta(load1, load1 - segDemand) + loadPenaltyDelta(load2, load2 + segDemand);
+        for (int j = 1; j <= positions; j++) {
+            int delta = segmentMoveDelta(path1, i, segLen, path2, j) + penalty;
+            if (delta < move.delta) {
+                move.delta = delta;
+                move.from  = i;
+                move.to    = j;
             }
         }
     }
+}
 
-    if (bestFromRoute == -1) return false; 
+/*
+ * Descripción: Evalúa todos los intercambios de un cliente de r1 con un cliente de r2 y
+ * memoriza el mejor que respete la capacidad de ambas rutas.
+ * Entrada: Solución, rutas involucradas, entrada de la caché.
+ * Salida: Ninguna (actualiza 'move').
+ */
+void VNS::evaluateSwapPair(const Solution& sol, int r1, int r2, PairMove& move) const {
+    const auto& routes = sol.getRoutes();
+    const vector<int>& path1 = routes[r1].getPath();
+    const vector<int>& path2 = routes[r2].getPath();
+    int clients1 = path1.size() - 2;
+    int clients2 = path2.size() - 2;
+    int load1 = routes[r1].getCurrentLoad();
+    int load2 = routes[r2].getCurrentLoad();
+
+    move = PairMove();
+    move.evaluatedAt = moveClock;
+
+    for (int i = 1; i <= clients1; i++) {
+        int dem1 = parserData->getClients()[path1[i]].getDemand();
+
+        for (int j = 1; j <= clients2; j++) {
+            int dem2 = parserData->getClients()[path2[j]].getDemand();
+
+            int newLoad1 = load1 - dem1 + dem2;
+            int newLoad2 = load2 - dem2 + dem1;
+            if (newLoad1 > loadLimit || newLoad2 > loadLimit) continue;
+
+            int delta = swapDelta(path1, i, path2, j)
+                      + loadPenaltyDelta(load1, newLoad1) + loadPenaltyDelta(load2, newLoad2);
+            if (delta < move.delta) {
+                move.delta = delta;
+                move.from  = i;
+                move.to    = j;
+            }
+        }
+    }
+}
 
-    Solution newSol(parserData);
-    for (int r = 0; r < numRoutes; r++) {
-        const vector<int>& oldPath = routes[r].getPath();
-        Route newRoute(Q, parserData);
+/*
+ * Descripción: Indica si la vecindad actual se evalúa repartiendo los pares de rutas entre
+ * hilos: sólo con Best-Improvement (las otras políticas cortan el recorrido antes) y cuando
+ * hay suficientes pares.
+ * Entrada: Política de la vecindad.
+ * Salida: Booleano.
+ */
+bool VNS::parallelScan(SearchPolicy policy) const {
+    return evalThreads > 1 && policy == SearchPolicy::BestImprovement &&
+           (int)scanOrder.size() >= PARALLEL_MIN_PAIRS;
+}
 
-        if (r == bestFromRoute) {
-            for (int i = 1; i < (int)oldPath.size() - 1; i++) {
-                if (i == bestFromPos) continue;
-                newRoute.addClient(oldPath[i]);
+/*
+ * Descripción: Recorre los pares de rutas de scanOrder en bloques contiguos repartidos entre
+ * los hilos. Cada bloque reevalúa sus pares desactualizados (cada par escribe sólo su propia
+ * entrada de la caché) y guarda su mejor movimiento; la reducción posterior elige el menor
+ * delta y, ante empates, el de menor índice en scanOrder, por lo que el resultado coincide
+ * con el recorrido secuencial independientemente del número de hilos.
+ * Entrada: Solución, caché a usar, largo del segmento (Relocate / Or-Opt).
+ * Salida: Índice en scanOrder del mejor par mejorador, o -1 si no hay.
+ */
+int VNS::parallelPairScan(const Solution& sol, MoveCache which, int segLen) {
+    int numRoutes = sol.getRoutes().size();
+    int numPairs  = scanOrder.size();
+    int numBlocks = min(numPairs, evalPool->size() * BLOCKS_PER_THREAD);
+    int blockSize = (numPairs + numBlocks - 1) / numBlocks;
+    vector<PairMove>& cache = pairCache[which];
+
+    blockBest.assign(numBlocks, { 0, -1 });
+    evalPool->run(numBlocks, [&](int block, int) {
+        int end = min(numPairs, (block + 1) * blockSize);
+        for (int k = block * blockSize; k < end; k++) {
+            auto [r1, r2] = scanUnits[scanOrder[k]];
+            PairMove& move = cache[r1 * numRoutes + r2];
+            if (!isPairCurrent(move, r1, r2)) {
+                if (which == CACHE_SWAP) evaluateSwapPair(sol, r1, r2, move);
+                else                     evaluateSegmentPair(sol, segLen, r1, r2, move);
             }
-        } else if (r == bestToRoute) {
-            int movedClient = routes[bestFromRoute].getPath()[bestFromPos];
-            for (int i = 1; i < (int)oldPath.size() - 1; i++) {
-                if (i == bestToPos) newRoute.addClient(movedClient);
-                newRoute.addClient(oldPath[i]);
+            if (move.delta < blockBest[block].first) blockBest[block] = { move.delta, k };
+        }
+    });
+
+    pair<int,int> best = { 0, -1 };
+    for (const auto& candidate : blockBest) {
+        if (candidate.first < best.first) best = candidate;
+    }
+    return best.second;
+}
+
+/*
+ * Descripción: Define cuántos hilos reparten la evaluación de pares de rutas en cada paso.
+ * Entrada: Número de hilos (1 = secuencial).
+ * Salida: Ninguna.
+ */
+void VNS::setEvaluationThreads(int threads) {
+    threads = max(1, threads);
+    if (threads == evalThreads) return;
+    evalThreads = threads;
+    evalPool.reset(threads > 1 ? new ThreadPool(threads) : nullptr);
+}
+
+/*
+ * Descripción: Recalcula el sector polar de una ruta (se invoca sólo cuando la ruta cambia).
+ * Entrada: Índice de la ruta, secuencia de la ruta.
+ * Salida: Ninguna (actualiza routeSectors).
+ */
+void VNS::updateRouteSector(int route, const vector<int>& path) {
+    if (path.size() <= 2) {
+        routeSectors[route] = CircleSector();
+        return;
+    }
+    routeSectors[route].initialize(polarAngle[path[1]]);
+    for (int i = 2; i < (int)path.size() - 1; i++) routeSectors[route].extend(polarAngle[path[i]]);
+}
+
+/*
+ * Descripción: Activa o desactiva la poda geométrica de pares de rutas en las vecindades
+ * exhaustivas de Relocate, Or-Opt y Swap.
+ * Entrada: Activación, holgura angular en grados con que se ensancha cada sector.
+ * Salida: Ninguna.
+ */
+void VNS::setSectorPruning(bool enabled, double toleranceDegrees) {
+    pruningTolerance = enabled ? (int)(65536.0 * max(0.0, toleranceDegrees) / 360.0) : -1;
+}
+
+/*
+ * Descripción: Retorna las tres posiciones más baratas para insertar 'client' en la ruta
+ * 'route' (sin retirar a nadie de ella). Se memorizan por (ruta, cliente) y se recalculan
+ * sólo si la ruta cambió desde el último cálculo.
+ * Entrada: Solución, cliente, ruta destino.
+ * Salida: Referencia a las tres mejores inserciones (costo y nodo predecesor).
+ */
+const VNS::InsertionTop3& VNS::bestInsertions(const Solution& sol, int client, int route) {
+    InsertionTop3& top = insertionCache[(size_t)route * (parserData->getDimension() + 1) + client];
+    if (top.evaluatedAt >= lastModified[route]) return top;
+
+    top.evaluatedAt = moveClock;
+    for (int t = 0; t < 3; t++) { top.cost[t] = INT_MAX; top.after[t] = -1; }
+
+    const vector<int>& path = sol.getRoutes()[route].getPath();
+    for (int j = 1; j < (int)path.size(); j++) {
+        int cost = insertionCost(path[j - 1], client, path[j]);
+        if (cost >= top.cost[2]) continue;
+
+        int t = 2;
+        while (t > 0 && cost < top.cost[t - 1]) {
+            top.cost[t]  = top.cost[t - 1];
+            top.after[t] = top.after[t - 1];
+            t--;
+        }
+        top.cost[t]  = cost;
+        top.after[t] = path[j - 1];
+    }
+    return top;
+}
+
+/*
+ * Descripción: Evalúa todos los SWAP* entre r1 y r2: cada cliente u de r1 se cambia por un
+ * cliente v de r2, y cada uno se reinserta en la mejor posición de la otra ruta (no
+ * necesariamente la que deja el otro). La mejor posición se obtiene de las tres mejores
+ * inserciones precalculadas, descartando las adyacentes al cliente que sale, o de la
+ * posición que éste deja libre.
+ * Entrada: Solución, rutas involucradas, entrada de la caché.
+ * Salida: Ninguna (actualiza 'move').
+ */
+void VNS::evaluateSwapStarPair(const Solution& sol, int r1, int r2, PairMove& move) {
+    const auto& routes = sol.getRoutes();
+    const vector<int>& path1 = routes[r1].getPath();
+    const vector<int>& path2 = routes[r2].getPath();
+    int clients1 = path1.size() - 2;
+    int clients2 = path2.size() - 2;
+    int load1 = routes[r1].getCurrentLoad();
+    int load2 = routes[r2].getCurrentLoad();
+
+    move = PairMove();
+    move.evaluatedAt = moveClock;
+
+    for (int i = 1; i <= clients1; i++) {
+        int u = path1[i], pu = path1[i - 1], nu = path1[i + 1];
+        int demU = parserData->getClients()[u].getDemand();
+        int removalU = removalSaving(pu, u, nu);
+        const InsertionTop3& topU = bestInsertions(sol, u, r2);
+
+        for (int j = 1; j <= clients2; j++) {
+            int v = path2[j], pv = path2[j - 1], nv = path2[j + 1];
+            int demV = parserData->getClients()[v].getDemand();
+
+            int newLoad1 = load1 - demU + demV;
+            int newLoad2 = load2 - demV + demU;
+            if (newLoad1 > loadLimit || newLoad2 > loadLimit) continue;
+
+            int removalV = removalSaving(pv, v, nv);
+
+            // u entra en r2 (sin v): en el hueco de v o en una de sus tres mejores posiciones
+            int insU = insertionCost(pv, u, nv), afterU = pv;
+            for (int t = 0; t < 3; t++) {
+                if (topU.after[t] == -1) break;
+                if (topU.after[t] == pv || topU.after[t] == v) continue;
+                if (topU.cost[t] < insU) { insU = topU.cost[t]; afterU = topU.after[t]; }
+                break;
             }
-            if (bestToPos == (int)oldPath.size() - 1) {
-                newRoute.addClient(movedClient);
+
+            // v entra en r1 (sin u)
+            const InsertionTop3& topV = bestInsertions(sol, v, r1);
+            int insV = insertionCost(pu, v, nu), afterV = pu;
+            for (int t = 0; t < 3; t++) {
+                if (topV.after[t] == -1) break;
+                if (topV.after[t] == pu || topV.after[t] == u) continue;
+                if (topV.cost[t] < insV) { insV = topV.cost[t]; afterV = topV.after[t]; }
+                break;
             }
-        } else {
-            for (int i = 1; i < (int)oldPath.size() - 1; i++) {
-                newRoute.addClient(oldPath[i]);
+
+            int delta = removalU + removalV + insU + insV
+                      + loadPenaltyDelta(load1, newLoad1) + loadPenaltyDelta(load2, newLoad2);
+            if (delta < move.delta) {
+                move.delta     = delta;
+                move.from      = i;
+                move.to        = j;
+                move.fromAfter = afterV;
+                move.toAfter   = afterU;
             }
         }
-        
-        if (newRoute.getPath().size() > 2) {
-            newSol.addRoute(newRoute);
-        }
     }
+}
+
+// ─────────────────────────────────────────────────────────────
+// Políticas de Exploración
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Define la política de exploración de todas las vecindades.
+ * Entrada: Política, tamaño de la muestra para la política Sampled.
+ * Salida: Ninguna.
+ */
+void VNS::setSearchPolicy(SearchPolicy policy, int sample) {
+    for (int n = 0; n < NUM_NEIGHBORHOODS; n++) policies[n] = policy;
+    sampleSize = max(1, sample);
+}
+
+/*
+ * Descripción: Define la política de exploración de una vecindad en particular.
+ * Entrada: Vecindad, política.
+ * Salida: Ninguna.
+ */
+void VNS::setSearchPolicy(Neighborhood neighborhood, SearchPolicy policy) {
+    policies[neighborhood] = policy;
+}
+
+/*
+ * Descripción: Cada cuántas unidades exploradas (pares de rutas o clientes) se revisa si ya
+ * hay un movimiento mejorador para aplicarlo: 1 en First-Improvement, el tamaño de la
+ * muestra en Sampled y nunca (recorrido completo) en Best-Improvement.
+ * Entrada: Política.
+ * Salida: Tamaño del bloque.
+ */
+int VNS::scanChunk(SearchPolicy policy) const {
+    if (policy == SearchPolicy::FirstImprovement) return 1;
+    if (policy == SearchPolicy::Sampled)          return sampleSize;
+    return INT_MAX;
+}
+
+/*
+ * Descripción: Prepara el orden de recorrido de las unidades: el natural en Best-Improvement
+ * (resultados reproducibles respecto del recorrido completo) y uno aleatorio en las demás.
+ * Entrada: Política.
+ * Salida: Ninguna (llena 'scanOrder' según 'scanUnits').
+ */
+void VNS::shuffleScanOrder(SearchPolicy policy) {
+    scanOrder.resize(scanUnits.size());
+    for (size_t u = 0; u < scanUnits.size(); u++) scanOrder[u] = u;
+    if (policy != SearchPolicy::BestImprovement) shuffle(scanOrder.begin(), scanOrder.end(), rng);
+}
 
-    if (newSol.isValid() && newSol.getTotalCost() < sol.getTotalCost()) {
-        sol = newSol;
-        return true;
+/*
+ * Descripción: Unidades del modo granular: los clientes (ruta, posición) donde puede comenzar
+ * un segmento de largo 'segLen' sin vaciar su ruta (segLen = 0 para Swap: todos los clientes).
+ * Entrada: Solución, largo del segmento, política.
+ * Salida: Ninguna.
+ */
+void VNS::buildScanUnits(const Solution& sol, int segLen, SearchPolicy policy) {
+    const auto& routes = sol.getRoutes();
+    scanUnits.clear();
+    for (int r = 0; r < (int)routes.size(); r++) {
+        int clients = routes[r].getPath().size() - 2;
+        if (segLen > 0 && clients <= segLen) continue;
+        int lastStart = segLen > 0 ? clients - segLen + 1 : clients;
+        for (int i = 1; i <= lastStart; i++) scanUnits.push_back({r, i});
     }
-    return false;
+    shuffleScanOrder(policy);
+}
+
+/*
+ * Descripción: Unidades del modo exhaustivo: los pares de rutas (r1, r2), ordenados o no.
+ * Con sectorTolerance >= 0 se descartan los pares cuyos sectores polares no se solapan.
+ * Entrada: Número de rutas, si el par es simétrico (r1 < r2), política, holgura angular
+ * (-1 = sin poda).
+ * Salida: Cantidad de pares descartados por la poda.
+ */
+int VNS::buildScanPairs(int numRoutes, bool symmetric, SearchPolicy policy, int sectorTolerance) {
+    int discarded = 0;
+    scanUnits.clear();
+    for (int r1 = 0; r1 < numRoutes; r1++) {
+        for (int r2 = symmetric ? r1 + 1 : 0; r2 < numRoutes; r2++) {
+            if (r1 == r2) continue;
+            if (sectorTolerance >= 0 &&
+                !CircleSector::overlap(routeSectors[r1], routeSectors[r2], sectorTolerance)) {
+                discarded++;
+                continue;
+            }
+            scanUnits.push_back({r1, r2});
+        }
+    }
+    shuffleScanOrder(policy);
+    return discarded;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Estructuras de Vecindad
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Explora la vecindad "Relocate". Evalúa mover un cliente de su ruta actual 
+ * a la mejor posición posible dentro de cualquier otra ruta distinta. Equivale a un
+ * Or-Opt con segmentos de un solo cliente.
+ * Entrada: Solución actual por referencia.
+ * Salida: Booleano indicando si se aplicó un movimiento que mejora estrictamente el costo.
+ */
+bool VNS::neighborhoodRelocate(Solution& sol) {
+    return neighborhoodOrOpt(sol, 1);
 }
 
 /*
  * Descripción: Explora la vecindad "Swap". Evalúa intercambiar la posición de dos clientes 
  * pertenecientes a rutas distintas. Aplica el intercambio que genere la mayor reducción 
- * en la función objetivo sin violar restricciones de capacidad.
+ * en la función objetivo sin violar restricciones de capacidad. En modo exhaustivo sólo se
+ * reevalúan los pares de rutas modificados desde su última evaluación.
  * Entrada: Solución actual por referencia.
  * Salida: Booleano indicando si se logró una mejora estricta.
  */
@@ -159,80 +631,82 @@ bool VNS::neighborhoodSwap(Solution& sol) {
     int bestR1 = -1, bestI = -1;
     int bestR2 = -1, bestJ = -1;
 
-    for (int r1 = 0; r1 < numRoutes; r1++) {
-        const vector<int>& path1 = routes[r1].getPath();
-        int clients1 = path1.size() - 2;
+    SearchPolicy policy = policies[Neighborhood::Swap];
+    int chunk = scanChunk(policy);
 
-        for (int i = 1; i <= clients1; i++) {
-            int c1     = path1[i];
-            int prev1  = path1[i - 1];
-            int next1  = path1[i + 1];
-            int dem1   = parserData->getClients()[c1].getDemand();
+    if (granularity > 0) {
+        buildLocationMap(sol);
+        buildScanUnits(sol, 0, policy);
+        for (int k = 0; k < (int)scanOrder.size(); k++) {
+            auto [r1, i] = scanUnits[scanOrder[k]];
+            const vector<int>& path1 = routes[r1].getPath();
+            int dem1 = parserData->getClients()[path1[i]].getDemand();
 
-            for (int r2 = r1 + 1; r2 < numRoutes; r2++) {
+            swapCandidates(sol, path1[i], r1);
+            for (const auto& [r2, j] : candidates) {
                 const vector<int>& path2 = routes[r2].getPath();
-                int clients2 = path2.size() - 2;
-
-                for (int j = 1; j <= clients2; j++) {
-                    int c2     = path2[j];
-                    int prev2  = path2[j - 1];
-                    int next2  = path2[j + 1];
-                    int dem2   = parserData->getClients()[c2].getDemand();
-
-                    int newLoad1 = routes[r1].getCurrentLoad() - dem1 + dem2;
-                    int newLoad2 = routes[r2].getCurrentLoad() - dem2 + dem1;
-                    if (newLoad1 > Q || newLoad2 > Q) continue;
-
-                    int delta = 
-                        parserData->getDistance(prev1, c2) +
-                        parserData->getDistance(c2, next1) -
-                        parserData->getDistance(prev1, c1) -
-                        parserData->getDistance(c1, next1) +
-                        parserData->getDistance(prev2, c1) +
-                        parserData->getDistance(c1, next2) -
-                        parserData->getDistance(prev2, c2) -
-                        parserData->getDistance(c2, next2);
+                int dem2 = parserData->getClients()[path2[j]].getDemand();
 
-                    if (delta < bestDelta) {
-                        bestDelta = delta;
-                        bestR1 = r1; bestI = i;
-                        bestR2 = r2; bestJ = j;
-                    }
+                int load1 = routes[r1].getCurrentLoad(), newLoad1 = load1 - dem1 + dem2;
+                int load2 = routes[r2].getCurrentLoad(), newLoad2 = load2 - dem2 + dem1;
+                if (newLoad1 > loadLimit || newLoad2 > loadLimit) continue;
+
+                int delta = swapDelta(path1, i, path2, j)
+                          + loadPenaltyDelta(load1, newLoad1) + loadPenaltyDelta(load2, newLoad2);
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    bestR1 = r1; bestI = i;
+                    bestR2 = r2; bestJ = j;
+                }
+            }
+            if ((k + 1) % chunk == 0 && bestR1 != -1) break;
+        }
+    } else {
+        syncModifications(sol);
+        prunedPairs += buildScanPairs(numRoutes, true, policy, pruningTolerance);
+        vector<PairMove>& cache = pairCache[CACHE_SWAP];
+        if (parallelScan(policy)) {
+            int k = parallelPairScan(sol, CACHE_SWAP, 0);
+            if (k != -1) {
+                auto [r1, r2] = scanUnits[scanOrder[k]];
+                const PairMove& move = cache[r1 * numRoutes + r2];
+                bestR1 = r1; bestI = move.from;
+                bestR2 = r2; bestJ = move.to;
+            }
+        } else {
+            for (int k = 0; k < (int)scanOrder.size(); k++) {
+                auto [r1, r2] = scanUnits[scanOrder[k]];
+                PairMove& move = cache[r1 * numRoutes + r2];
+                if (!isPairCurrent(move, r1, r2)) evaluateSwapPair(sol, r1, r2, move);
+
+                if (move.delta < bestDelta) {
+                    bestDelta = move.delta;
+                    bestR1 = r1; bestI = move.from;
+                    bestR2 = r2; bestJ = move.to;
                 }
+                if ((k + 1) % chunk == 0 && bestR1 != -1) break;
             }
         }
     }
 
     if (bestR1 == -1) return false;
+    movesApplied++;
 
-    int c1 = routes[bestR1].getPath()[bestI];
-    int c2 = routes[bestR2].getPath()[bestJ];
-
-    Solution newSol(parserData);
-    for (int r = 0; r < numRoutes; r++) {
-        const vector<int>& oldPath = routes[r].getPath();
-        Route newRoute(Q, parserData);
-
-        for (int i = 1; i < (int)oldPath.size() - 1; i++) {
-            if (r == bestR1 && i == bestI)      newRoute.addClient(c2);
-            else if (r == bestR2 && i == bestJ) newRoute.addClient(c1);
-            else                                newRoute.addClient(oldPath[i]);
-        }
-        if (newRoute.getPath().size() > 2) newSol.addRoute(newRoute);
-    }
+    vector<int> path1 = routes[bestR1].getPath();
+    vector<int> path2 = routes[bestR2].getPath();
+    swap(path1[bestI], path2[bestJ]);
 
-    if (newSol.isValid() && newSol.getTotalCost() < sol.getTotalCost()) {
-        sol = newSol;
-        return true;
-    }
-    return false;
+    sol.replaceRoute(bestR1, Route(Q, parserData, path1));
+    sol.replaceRoute(bestR2, Route(Q, parserData, path2));
+    return true;
 }
 
 /*
  * Descripción: Explora la vecindad "Or-Opt". Extrae un segmento de tamaño 'segLen' 
  * de una ruta y evalúa su inserción completa en la mejor posición disponible 
- * de cualquier otra ruta de la flota.
- * Entrada: Solución actual por referencia, longitud del segmento a mover (usualmente 2 o 3).
+ * de cualquier otra ruta de la flota. En modo exhaustivo sólo se reevalúan los pares
+ * de rutas modificados desde su última evaluación.
+ * Entrada: Solución actual por referencia, longitud del segmento a mover (1, 2 o 3).
  * Salida: Booleano indicando si se logró una mejora estricta.
  */
 bool VNS::neighborhoodOrOpt(Solution& sol, int segLen) {
@@ -244,89 +718,741 @@ bool VNS::neighborhoodOrOpt(Solution& sol, int segLen) {
     int bestR1      = -1, bestSegStart = -1;
     int bestR2      = -1, bestInsertPos = -1;
 
-    for (int r1 = 0; r1 < numRoutes; r1++) {
-        const vector<int>& path1 = routes[r1].getPath();
-        int clients1 = path1.size() - 2;
-        if (clients1 <= segLen) continue; 
+    SearchPolicy policy = policies[Neighborhood::Relocate + segLen - 1];
+    int chunk = scanChunk(policy);
+
+    if (granularity > 0) {
+        buildLocationMap(sol);
+        buildScanUnits(sol, segLen, policy);
+        for (int k = 0; k < (int)scanOrder.size(); k++) {
+            auto [r1, i] = scanUnits[scanOrder[k]];
+            const vector<int>& path1 = routes[r1].getPath();
 
-        for (int i = 1; i <= clients1 - segLen + 1; i++) {
             int segDemand = 0;
             for (int s = 0; s < segLen; s++)
                 segDemand += parserData->getClients()[path1[i + s]].getDemand();
+            int load1 = routes[r1].getCurrentLoad();
+            int sourcePenalty = loadPenaltyDelta(load1, load1 - segDemand);
 
-            int prevSeg = path1[i - 1];
-            int nextSeg = path1[i + segLen]; 
-            int segFirst = path1[i];
-            int segLast  = path1[i + segLen - 1];
+            insertionCandidates(sol, path1[i], path1[i + segLen - 1], r1);
+            for (const auto& [r2, j] : candidates) {
+                int load2 = routes[r2].getCurrentLoad();
+                if (load2 + segDemand > loadLimit) continue;
 
-            int saving = parserData->getDistance(prevSeg, nextSeg)
-                       - parserData->getDistance(prevSeg, segFirst)
-                       - parserData->getDistance(segLast, nextSeg);
+                int delta = segmentMoveDelta(path1, i, segLen, routes[r2].getPath(), j)
+                          + sourcePenalty + loadPenaltyDelta(load2, load2 + segDemand);
+                if (delta < bestDelta) {
+                    bestDelta    = delta;
+                    bestR1       = r1; bestSegStart  = i;
+                    bestR2       = r2; bestInsertPos = j;
+                }
+            }
+            if ((k + 1) % chunk == 0 && bestR1 != -1) break;
+        }
+    } else {
+        syncModifications(sol);
+        prunedPairs += buildScanPairs(numRoutes, false, policy, pruningTolerance);
+        vector<PairMove>& cache = pairCache[segLen - 1];
+        if (parallelScan(policy)) {
+            int k = parallelPairScan(sol, MoveCache(segLen - 1), segLen);
+            if (k != -1) {
+                auto [r1, r2] = scanUnits[scanOrder[k]];
+                const PairMove& move = cache[r1 * numRoutes + r2];
+                bestR1 = r1; bestSegStart  = move.from;
+                bestR2 = r2; bestInsertPos = move.to;
+            }
+        } else {
+            for (int k = 0; k < (int)scanOrder.size(); k++) {
+                auto [r1, r2] = scanUnits[scanOrder[k]];
+                PairMove& move = cache[r1 * numRoutes + r2];
+                if (!isPairCurrent(move, r1, r2)) evaluateSegmentPair(sol, segLen, r1, r2, move);
+
+                if (move.delta < bestDelta) {
+                    bestDelta    = move.delta;
+                    bestR1       = r1; bestSegStart  = move.from;
+                    bestR2       = r2; bestInsertPos = move.to;
+                }
+                if ((k + 1) % chunk == 0 && bestR1 != -1) break;
+            }
+        }
+    }
 
-            for (int r2 = 0; r2 < numRoutes; r2++) {
-                if (r1 == r2) continue;
-                if (routes[r2].getCurrentLoad() + segDemand > Q) continue;
+    if (bestR1 == -1) return false;
+    movesApplied++;
+
+    // El origen conserva al menos un cliente, así que los índices de las rutas no cambian
+    vector<int> srcPath = routes[bestR1].getPath();
+    vector<int> dstPath = routes[bestR2].getPath();
+    dstPath.insert(dstPath.begin() + bestInsertPos,
+                   srcPath.begin() + bestSegStart, srcPath.begin() + bestSegStart + segLen);
+    srcPath.erase(srcPath.begin() + bestSegStart, srcPath.begin() + bestSegStart + segLen);
+
+    sol.replaceRoute(bestR1, Route(Q, parserData, srcPath));
+    sol.replaceRoute(bestR2, Route(Q, parserData, dstPath));
+    return true;
+}
 
-                const vector<int>& path2 = routes[r2].getPath();
-                int positions = path2.size() - 1;
+/*
+ * Descripción: Explora la vecindad "2-OPT*" (intercambio de colas entre dos rutas). Para cada
+ * cliente u y cada vecino cercano v de otra ruta evalúa las dos reconexiones:
+ *  - directa:   [.. u | y ..] y [.. v | x ..]  (u pasa a continuar con la cola de v)
+ *  - invertida: [.. u, v ..inicio de v] y [fin de u.. x, y ..]  (crea la arista (u, v))
+ * donde x e y son los sucesores de u y v. Cada candidato se evalúa en O(1) con las cargas
+ * acumuladas. Si una ruta queda vacía se elimina.
+ * Entrada: Solución actual por referencia.
+ * Salida: Booleano indicando si se logró una mejora estricta.
+ */
+bool VNS::neighborhoodTwoOptStar(Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int Q = parserData->getCapacity();
 
-                for (int j = 1; j <= positions; j++) {
-                    int prevJ = path2[j - 1];
-                    int nextJ = path2[j];
+    int  bestDelta = 0;
+    int  bestR1 = -1, bestI = -1;
+    int  bestR2 = -1, bestJ = -1;
+    bool bestReversed = false;
 
-                    int insertCost = parserData->getDistance(prevJ, segFirst)
-                                   + parserData->getDistance(segLast, nextJ)
-                                   - parserData->getDistance(prevJ, nextJ);
+    SearchPolicy policy = policies[Neighborhood::TwoOptStar];
+    int chunk = scanChunk(policy);
+    int neighborsK = neighborListSize();
 
-                    int delta = insertCost + saving; 
+    buildLocationMap(sol);
+    buildPrefixLoads(sol);
+    buildScanUnits(sol, 0, policy);
 
-                    if (delta < bestDelta) {
-                        bestDelta    = delta;
-                        bestR1       = r1; bestSegStart  = i;
-                        bestR2       = r2; bestInsertPos = j;
+    for (int k = 0; k < (int)scanOrder.size(); k++) {
+        auto [r1, i] = scanUnits[scanOrder[k]];
+        const vector<int>& path1 = routes[r1].getPath();
+        int u = path1[i], x = path1[i + 1];
+        int loadA = routes[r1].getCurrentLoad();
+        int headA = prefixLoad[r1][i];
+
+        const auto& neighbors = parserData->getSortedNeighbors(u);
+        int limit = min(neighborsK, (int)neighbors.size());
+        for (int n = 0; n < limit; n++) {
+            int v = neighbors[n].id;
+            if (v == 1 || routeOf[v] == r1) continue;
+
+            int r2 = routeOf[v], j = posOf[v];
+            const vector<int>& path2 = routes[r2].getPath();
+            int y = path2[j + 1];
+            int loadB = routes[r2].getCurrentLoad();
+            int headB = prefixLoad[r2][j];
+
+            int removed = parserData->getDistance(u, x) + parserData->getDistance(v, y);
+
+            int newA = headA + loadB - headB, newB = headB + loadA - headA;
+            if (newA <= loadLimit && newB <= loadLimit) {
+                int delta = parserData->getDistance(u, y) + parserData->getDistance(v, x) - removed
+                          + loadPenaltyDelta(loadA, newA) + loadPenaltyDelta(loadB, newB);
+                if (delta < bestDelta) {
+                    bestDelta = delta; bestReversed = false;
+                    bestR1 = r1; bestI = i; bestR2 = r2; bestJ = j;
+                }
+            }
+
+            newA = headA + headB;
+            newB = (loadA - headA) + (loadB - headB);
+            if (newA <= loadLimit && newB <= loadLimit) {
+                int delta = parserData->getDistance(u, v) + parserData->getDistance(x, y) - removed
+                          + loadPenaltyDelta(loadA, newA) + loadPenaltyDelta(loadB, newB);
+                if (delta < bestDelta) {
+                    bestDelta = delta; bestReversed = true;
+                    bestR1 = r1; bestI = i; bestR2 = r2; bestJ = j;
+                }
+            }
+        }
+        if ((k + 1) % chunk == 0 && bestR1 != -1) break;
+    }
+
+    if (bestR1 == -1) return false;
+    movesApplied++;
+
+    const vector<int>& pathA = routes[bestR1].getPath();
+    const vector<int>& pathB = routes[bestR2].getPath();
+    vector<int> newA(pathA.begin(), pathA.begin() + bestI + 1);
+    vector<int> newB;
+
+    if (!bestReversed) {
+        newA.insert(newA.end(), pathB.begin() + bestJ + 1, pathB.end());
+        newB.assign(pathB.begin(), pathB.begin() + bestJ + 1);
+        newB.insert(newB.end(), pathA.begin() + bestI + 1, pathA.end());
+    } else {
+        newA.insert(newA.end(), pathB.rend() - bestJ - 1, pathB.rend() - 1);
+        newA.push_back(pathB.back());
+        newB.push_back(pathA.front());
+        newB.insert(newB.end(), pathA.rbegin() + 1, pathA.rend() - bestI - 1);
+        newB.insert(newB.end(), pathB.begin() + bestJ + 1, pathB.end());
+    }
+
+    bool emptied = newA.size() <= 2 || newB.size() <= 2;
+    sol.replaceRoute(bestR1, Route(Q, parserData, newA));
+    sol.replaceRoute(bestR2, Route(Q, parserData, newB));
+    if (emptied) sol.removeEmptyRoutes();
+    return true;
+}
+
+/*
+ * Descripción: Explora la vecindad "CROSS-Exchange": intercambia un segmento de hasta
+ * CROSS_MAX_SEGMENT clientes que sigue a u con un segmento de otra ruta que comienza o
+ * termina en un vecino cercano v de u, de modo que se crea la arista (u, v). Ambos
+ * segmentos pueden insertarse invertidos. Cada candidato se evalúa en O(1) con las
+ * cargas acumuladas (las distancias son simétricas, así que invertir un segmento no
+ * cambia su costo interno).
+ * Entrada: Solución actual por referencia.
+ * Salida: Booleano indicando si se logró una mejora estricta.
+ */
+bool VNS::neighborhoodCrossExchange(Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int Q = parserData->getCapacity();
+
+    int  bestDelta = 0;
+    int  bestR1 = -1, bestI = -1, bestLenA = 0;
+    int  bestR2 = -1, bestStartB = -1, bestEndB = -1;
+    bool bestRevA = false, bestRevB = false;
+
+    SearchPolicy policy = policies[Neighborhood::CrossExchange];
+    int chunk = scanChunk(policy);
+    int neighborsK = neighborListSize();
+
+    buildLocationMap(sol);
+    buildPrefixLoads(sol);
+    buildScanUnits(sol, 0, policy);
+
+    for (int k = 0; k < (int)scanOrder.size(); k++) {
+        auto [r1, i] = scanUnits[scanOrder[k]];
+        const vector<int>& path1 = routes[r1].getPath();
+        int clients1 = path1.size() - 2;
+        if (i >= clients1) continue;  // u necesita al menos un cliente detrás
+
+        int u = path1[i];
+        int loadA = routes[r1].getCurrentLoad();
+
+        const auto& neighbors = parserData->getSortedNeighbors(u);
+        int limit = min(neighborsK, (int)neighbors.size());
+        for (int n = 0; n < limit; n++) {
+            int v = neighbors[n].id;
+            if (v == 1 || routeOf[v] == r1) continue;
+
+            int r2 = routeOf[v], j = posOf[v];
+            const vector<int>& path2 = routes[r2].getPath();
+            int clients2 = path2.size() - 2;
+            int loadB = routes[r2].getCurrentLoad();
+
+            for (int lenA = 1; lenA <= CROSS_MAX_SEGMENT && i + lenA <= clients1; lenA++) {
+                int aFirst = path1[i + 1], aLast = path1[i + lenA];
+                int nA     = path1[i + lenA + 1];
+                int segLoadA = prefixLoad[r1][i + lenA] - prefixLoad[r1][i];
+                int removedA = parserData->getDistance(u, aFirst) + parserData->getDistance(aLast, nA);
+
+                for (int lenB = 1; lenB <= CROSS_MAX_SEGMENT; lenB++) {
+                    for (int revB = 0; revB <= 1; revB++) {
+                        if (revB && lenB == 1) continue;
+
+                        // Segmento de B: comienza en v (directo) o termina en v (se inserta invertido)
+                        int s = revB ? j - lenB + 1 : j;
+                        int e = revB ? j : j + lenB - 1;
+                        if (s < 1 || e > clients2) continue;
+
+                        int segLoadB = prefixLoad[r2][e] - prefixLoad[r2][s - 1];
+                        int newA = loadA - segLoadA + segLoadB, newB = loadB - segLoadB + segLoadA;
+                        if (newA > loadLimit || newB > loadLimit) continue;
+
+                        int pB = path2[s - 1], nB = path2[e + 1];
+                        int bLast = revB ? path2[s] : path2[e];   // último nodo del segmento en A
+                        int base = parserData->getDistance(u, v) + parserData->getDistance(bLast, nA)
+                                 - removedA
+                                 - parserData->getDistance(pB, path2[s]) - parserData->getDistance(path2[e], nB)
+                                 + loadPenaltyDelta(loadA, newA) + loadPenaltyDelta(loadB, newB);
+
+                        for (int revA = 0; revA <= 1; revA++) {
+                            if (revA && lenA == 1) continue;
+                            int inFirst = revA ? aLast : aFirst;
+                            int inLast  = revA ? aFirst : aLast;
+                            int delta = base + parserData->getDistance(pB, inFirst)
+                                             + parserData->getDistance(inLast, nB);
+                            if (delta < bestDelta) {
+                                bestDelta = delta;
+                                bestR1 = r1; bestI = i; bestLenA = lenA;
+                                bestR2 = r2; bestStartB = s; bestEndB = e;
+                                bestRevA = revA; bestRevB = revB;
+                            }
+                        }
                     }
                 }
             }
         }
+        if ((k + 1) % chunk == 0 && bestR1 != -1) break;
+    }
+
+    if (bestR1 == -1) return false;
+    movesApplied++;
+
+    const vector<int>& pathA = routes[bestR1].getPath();
+    const vector<int>& pathB = routes[bestR2].getPath();
+    vector<int> segA(pathA.begin() + bestI + 1, pathA.begin() + bestI + bestLenA + 1);
+    vector<int> segB(pathB.begin() + bestStartB, pathB.begin() + bestEndB + 1);
+    if (bestRevA) reverse(segA.begin(), segA.end());
+    if (bestRevB) reverse(segB.begin(), segB.end());
+
+    vector<int> newA(pathA.begin(), pathA.begin() + bestI + 1);
+    newA.insert(newA.end(), segB.begin(), segB.end());
+    newA.insert(newA.end(), pathA.begin() + bestI + bestLenA + 1, pathA.end());
+
+    vector<int> newB(pathB.begin(), pathB.begin() + bestStartB);
+    newB.insert(newB.end(), segA.begin(), segA.end());
+    newB.insert(newB.end(), pathB.begin() + bestEndB + 1, pathB.end());
+
+    sol.replaceRoute(bestR1, Route(Q, parserData, newA));
+    sol.replaceRoute(bestR2, Route(Q, parserData, newB));
+    return true;
+}
+
+/*
+ * Descripción: Explora la vecindad "SWAP*": intercambia dos clientes de rutas distintas
+ * reinsertando cada uno en su mejor posición de la otra ruta. Sólo se evalúan pares de rutas
+ * cuyos sectores polares se superponen, y el mejor movimiento de cada par se memoriza hasta
+ * que alguna de las dos rutas cambie.
+ * Entrada: Solución actual por referencia.
+ * Salida: Booleano indicando si se logró una mejora estricta.
+ */
+bool VNS::neighborhoodSwapStar(Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int numRoutes = routes.size();
+    int Q = parserData->getCapacity();
+
+    int bestDelta = 0;
+    int bestR1 = -1, bestR2 = -1;
+    PairMove bestMove;
+
+    SearchPolicy policy = policies[Neighborhood::SwapStar];
+    int chunk = scanChunk(policy);
+
+    syncModifications(sol);
+    buildScanPairs(numRoutes, true, policy, 0);
+    vector<PairMove>& cache = pairCache[CACHE_SWAPSTAR];
+
+    for (int k = 0; k < (int)scanOrder.size(); k++) {
+        auto [r1, r2] = scanUnits[scanOrder[k]];
+        PairMove& move = cache[r1 * numRoutes + r2];
+        if (!isPairCurrent(move, r1, r2)) evaluateSwapStarPair(sol, r1, r2, move);
+
+        if (move.delta < bestDelta) {
+            bestDelta = move.delta;
+            bestR1 = r1; bestR2 = r2;
+            bestMove = move;
+        }
+        if ((k + 1) % chunk == 0 && bestR1 != -1) break;
     }
 
     if (bestR1 == -1) return false;
+    movesApplied++;
 
-    const vector<int>& srcPath = routes[bestR1].getPath();
-    vector<int> segment;
-    for (int s = 0; s < segLen; s++)
-        segment.push_back(srcPath[bestSegStart + s]);
+    vector<int> path1 = routes[bestR1].getPath();
+    vector<int> path2 = routes[bestR2].getPath();
+    int u = path1[bestMove.from];
+    int v = path2[bestMove.to];
 
-    Solution newSol(parserData);
-    for (int r = 0; r < numRoutes; r++) {
-        const vector<int>& oldPath = routes[r].getPath();
-        Route newRoute(Q, parserData);
+    path1.erase(path1.begin() + bestMove.from);
+    path1.insert(find(path1.begin(), path1.end() - 1, bestMove.fromAfter) + 1, v);
+    path2.erase(path2.begin() + bestMove.to);
+    path2.insert(find(path2.begin(), path2.end() - 1, bestMove.toAfter) + 1, u);
 
-        if (r == bestR1) {
-            for (int i = 1; i < (int)oldPath.size() - 1; i++) {
-                if (i >= bestSegStart && i < bestSegStart + segLen) continue;
-                newRoute.addClient(oldPath[i]);
+    sol.replaceRoute(bestR1, Route(Q, parserData, path1));
+    sol.replaceRoute(bestR2, Route(Q, parserData, path2));
+    return true;
+}
+
+/*
+ * Descripción: Indica si la cadena que termina en la etiqueta dada ya pasa por una ruta.
+ * Entrada: Capa y etiqueta final de la cadena, ruta a consultar.
+ * Salida: Booleano.
+ */
+bool VNS::chainUsesRoute(int layer, int label, int route) const {
+    for (int l = layer; l >= 0 && label != -1; l--) {
+        if (chainLayers[l][label].route == route) return true;
+        label = chainLayers[l][label].pred;
+    }
+    return false;
+}
+
+/*
+ * Descripción: Explora la vecindad de "cadenas de expulsión": un cliente c0 sale de su ruta y
+ * entra en otra, posiblemente llena, de la que expulsa a un cliente c1, que a su vez entra en
+ * una tercera ruta, y así hasta EJECTION_MAX_DEPTH eslabones, terminando con una inserción
+ * sin expulsión. La mejor cadena se busca como un camino más corto por capas sobre el grafo
+ * de mejora granular (cada cliente sólo se mueve a rutas de sus vecinos cercanos), con una
+ * etiqueta por cliente y capa, sin repetir rutas a lo largo de la cadena y extendiendo sólo
+ * prefijos con ganancia (variación acumulada negativa). Las cadenas de un solo eslabón son
+ * Relocate y no se consideran. Siempre aplica la mejor cadena encontrada.
+ * Entrada: Solución actual por referencia.
+ * Salida: Booleano indicando si se logró una mejora estricta.
+ */
+bool VNS::neighborhoodEjectionChain(Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int Q = parserData->getCapacity();
+    int neighborsK = neighborListSize();
+    const auto& clientData = parserData->getClients();
+
+    syncModifications(sol);
+    buildLocationMap(sol);
+
+    int bestDelta = 0, bestLayer = -1, bestLabel = -1, bestRoute = -1, bestAfter = -1;
+    vector<int> targetRoutes;
+
+    // Capa 0: cualquier cliente puede iniciar la cadena saliendo de su ruta
+    chainLayers[0].clear();
+    for (int r = 0; r < (int)routes.size(); r++) {
+        const vector<int>& path = routes[r].getPath();
+        int load = routes[r].getCurrentLoad();
+        for (int i = 1; i < (int)path.size() - 1; i++) {
+            int delta = removalSaving(path[i - 1], path[i], path[i + 1])
+                      + loadPenaltyDelta(load, load - clientData[path[i]].getDemand());
+            if (delta < 0) chainLayers[0].push_back({ path[i], r, delta, -1, -1 });
+        }
+    }
+
+    for (int layer = 0; layer < EJECTION_MAX_DEPTH; layer++) {
+        bool lastLayer = layer + 1 == EJECTION_MAX_DEPTH;
+        if (!lastLayer) {
+            chainLayers[layer + 1].clear();
+            chainLabelOf.assign(parserData->getDimension() + 1, -1);
+        }
+
+        for (int l = 0; l < (int)chainLayers[layer].size(); l++) {
+            ChainLabel label = chainLayers[layer][l];
+            int m    = label.client;
+            int demM = clientData[m].getDemand();
+
+            // Rutas destino: las de los vecinos cercanos de m que la cadena aún no visita
+            targetRoutes.clear();
+            const auto& neighbors = parserData->getSortedNeighbors(m);
+            int limit = min(neighborsK, (int)neighbors.size());
+            for (int n = 0; n < limit; n++) {
+                int v = neighbors[n].id;
+                if (v == 1 || routeOf[v] == -1) continue;
+                int r = routeOf[v];
+                if (find(targetRoutes.begin(), targetRoutes.end(), r) != targetRoutes.end()) continue;
+                if (chainUsesRoute(layer, l, r)) continue;
+                targetRoutes.push_back(r);
             }
-        } else if (r == bestR2) {
-            for (int i = 1; i < (int)oldPath.size() - 1; i++) {
-                if (i == bestInsertPos)
-                    for (int c : segment) newRoute.addClient(c);
-                newRoute.addClient(oldPath[i]);
+
+            for (int r : targetRoutes) {
+                const vector<int>& path = routes[r].getPath();
+                int load = routes[r].getCurrentLoad();
+                const InsertionTop3& top = bestInsertions(sol, m, r);
+
+                // Cierre de la cadena: m entra en r sin expulsar a nadie
+                if (layer > 0 && load + demM <= loadLimit && top.after[0] != -1) {
+                    int delta = label.delta + top.cost[0] + loadPenaltyDelta(load, load + demM);
+                    if (delta < bestDelta) {
+                        bestDelta = delta;
+                        bestLayer = layer; bestLabel = l;
+                        bestRoute = r;     bestAfter = top.after[0];
+                    }
+                }
+                if (lastLayer) continue;
+
+                // Expulsión: m entra en r y sale e, que pasa a la capa siguiente
+                for (int j = 1; j < (int)path.size() - 1; j++) {
+                    int e = path[j], pe = path[j - 1], ne = path[j + 1];
+                    int newLoad = load - clientData[e].getDemand() + demM;
+                    if (newLoad > loadLimit) continue;
+
+                    int insM = insertionCost(pe, m, ne), afterM = pe;
+                    for (int t = 0; t < 3; t++) {
+                        if (top.after[t] == -1) break;
+                        if (top.after[t] == pe || top.after[t] == e) continue;
+                        if (top.cost[t] < insM) { insM = top.cost[t]; afterM = top.after[t]; }
+                        break;
+                    }
+
+                    int delta = label.delta + removalSaving(pe, e, ne) + insM + loadPenaltyDelta(load, newLoad);
+                    if (delta >= 0) continue;
+
+                    int& slot = chainLabelOf[e];
+                    if (slot == -1) {
+                        slot = chainLayers[layer + 1].size();
+                        chainLayers[layer + 1].push_back({ e, r, delta, l, afterM });
+                    } else if (delta < chainLayers[layer + 1][slot].delta) {
+                        chainLayers[layer + 1][slot] = { e, r, delta, l, afterM };
+                    }
+                }
             }
-            if (bestInsertPos == (int)oldPath.size() - 1)
-                for (int c : segment) newRoute.addClient(c);
-        } else {
-            for (int i = 1; i < (int)oldPath.size() - 1; i++)
-                newRoute.addClient(oldPath[i]);
         }
-        if (newRoute.getPath().size() > 2) newSol.addRoute(newRoute);
     }
 
-    if (newSol.isValid() && newSol.getTotalCost() < sol.getTotalCost()) {
-        sol = newSol;
-        return true;
+    if (bestLayer == -1) return false;
+    movesApplied++;
+
+    // Reconstrucción: cada ruta de la cadena pierde su cliente y recibe el del eslabón previo
+    int incoming = chainLayers[bestLayer][bestLabel].client;
+    vector<int> path = routes[bestRoute].getPath();
+    path.insert(find(path.begin(), path.end() - 1, bestAfter) + 1, incoming);
+    sol.replaceRoute(bestRoute, Route(Q, parserData, path));
+
+    bool emptied = false;
+    for (int layer = bestLayer, l = bestLabel; layer >= 0; l = chainLayers[layer][l].pred, layer--) {
+        const ChainLabel& label = chainLayers[layer][l];
+        path = routes[label.route].getPath();
+        path.erase(find(path.begin(), path.end(), label.client));
+        if (label.pred != -1) {
+            int previous = chainLayers[layer - 1][label.pred].client;
+            path.insert(find(path.begin(), path.end() - 1, label.insertAfter) + 1, previous);
+        }
+        emptied = emptied || path.size() <= 2;
+        sol.replaceRoute(label.route, Route(Q, parserData, path));
+    }
+
+    if (emptied) sol.removeEmptyRoutes();
+    return true;
+}
+
+/*
+ * Descripción: Ejecuta una vecindad inter-ruta.
+ * Entrada: Vecindad, solución actual por referencia.
+ * Salida: Booleano indicando si se aplicó un movimiento mejorador.
+ */
+bool VNS::applyNeighborhood(Neighborhood neighborhood, Solution& sol) {
+    switch (neighborhood) {
+        case Relocate:      return neighborhoodRelocate(sol);
+        case OrOpt2:        return neighborhoodOrOpt(sol, 2);
+        case OrOpt3:        return neighborhoodOrOpt(sol, 3);
+        case Swap:          return neighborhoodSwap(sol);
+        case TwoOptStar:    return neighborhoodTwoOptStar(sol);
+        case CrossExchange: return neighborhoodCrossExchange(sol);
+        case SwapStar:      return neighborhoodSwapStar(sol);
+        case EjectionChain: return neighborhoodEjectionChain(sol);
+        default:            return false;
+    }
+}
+
+/*
+ * Descripción: Acumula las estadísticas de una exploración de vecindad y actualiza sus
+ * promedios exponenciales de ganancia y tiempo.
+ * Entrada: Vecindad, si aplicó un movimiento, reducción del costo, segundos empleados.
+ * Salida: Ninguna.
+ */
+void VNS::recordStats(Neighborhood neighborhood, bool applied, double gain, double seconds) {
+    NeighborhoodStats& entry = stats[neighborhood];
+    entry.evaluations++;
+    if (applied) entry.improvements++;
+    entry.totalGain += gain;
+    entry.seconds   += seconds;
+
+    recentGain[neighborhood]    = ADAPTIVE_DECAY * recentGain[neighborhood] + gain;
+    recentSeconds[neighborhood] = ADAPTIVE_DECAY * recentSeconds[neighborhood] + seconds;
+}
+
+/*
+ * Descripción: Ordena las vecindades del VND por ganancia reciente por segundo, de mayor a
+ * menor. Las vecindades aún no exploradas van primero y los empates conservan el orden
+ * previo. Todas se siguen explorando: el orden sólo decide cuál se intenta antes.
+ * Entrada: Ninguna.
+ * Salida: Ninguna (reordena vndOrder).
+ */
+void VNS::reorderNeighborhoods() {
+    auto score = [&](Neighborhood n) {
+        if (stats[n].evaluations == 0) return numeric_limits<double>::infinity();
+        return recentGain[n] / max(recentSeconds[n], 1e-9);
+    };
+    stable_sort(vndOrder.begin(), vndOrder.end(),
+                [&](Neighborhood a, Neighborhood b) { return score(a) > score(b); });
+}
+
+/*
+ * Descripción: Reinicia las estadísticas y el historial del orden adaptativo.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void VNS::resetStats() {
+    for (int n = 0; n < NUM_NEIGHBORHOODS; n++) {
+        stats[n]         = NeighborhoodStats();
+        recentGain[n]    = 0.0;
+        recentSeconds[n] = 0.0;
     }
-    return false;
+}
+
+/*
+ * Descripción: Variable Neighborhood Descent: recorre las vecindades en el orden configurado
+ * y, tras cada movimiento aplicado, re-optimiza las rutas con KOpt y vuelve a la primera.
+ * En modo de capacidad penalizada desciende sobre el costo penalizado.
+ * Entrada: Solución por referencia.
+ * Salida: Ninguna (la solución queda en un mínimo local de todas las vecindades).
+ */
+void VNS::variableNeighborhoodDescent(Solution& sol) {
+    bool improved = true;
+    while (improved && !stopRequested(penalizedCost(sol))) {
+        improved = false;
+        if (adaptiveOrder) reorderNeighborhoods();
+
+        for (Neighborhood neighborhood : vndOrder) {
+            double costBefore = penalizedCost(sol);
+            Clock::time_point start = Clock::now();
+            bool applied = applyNeighborhood(neighborhood, sol);
+            recordStats(neighborhood, applied, costBefore - penalizedCost(sol),
+                        chrono::duration<double>(Clock::now() - start).count());
+
+            if (applied) {
+                sol = kopt.optimize(sol);
+                improved = true;
+                break;
+            }
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────
+// Capacidad Penalizada
+// ─────────────────────────────────────────────────────────────
+
+/*
+ * Descripción: Penalización (redondeada) de una ruta con la carga dada. Las vecindades
+ * evalúan la variación en O(1) a partir de la carga que cada ruta mantiene de forma
+ * incremental; como se redondea por ruta, la suma de las variaciones coincide exactamente
+ * con la del costo penalizado.
+ * Entrada: Carga de la ruta.
+ * Salida: Penalización en unidades de distancia (0 si no excede Q o el modo está inactivo).
+ */
+int VNS::excessPenalty(int load) const {
+    int excess = load - parserData->getCapacity();
+    if (!penalizedCapacity || excess <= 0) return 0;
+    return (int)lround(capacityPenalty * excess);
+}
+
+/*
+ * Descripción: Variación de la penalización de una ruta cuya carga pasa de 'oldLoad' a 'newLoad'.
+ * Entrada: Carga actual y carga tras el movimiento.
+ * Salida: Variación de la penalización (0 si el modo está inactivo).
+ */
+int VNS::loadPenaltyDelta(int oldLoad, int newLoad) const {
+    if (!penalizedCapacity) return 0;
+    return excessPenalty(newLoad) - excessPenalty(oldLoad);
+}
+
+/*
+ * Descripción: Exceso total de carga de una solución sobre la capacidad de los vehículos.
+ * Entrada: Solución.
+ * Salida: Suma de max(0, carga - Q) sobre todas las rutas.
+ */
+int VNS::totalExcess(const Solution& sol) const {
+    int excess = 0;
+    for (const auto& route : sol.getRoutes())
+        excess += max(0, route.getCurrentLoad() - parserData->getCapacity());
+    return excess;
+}
+
+/*
+ * Descripción: Costo de la solución más la penalización de capacidad de sus rutas.
+ * Entrada: Solución.
+ * Salida: Costo penalizado (igual al costo si el modo está inactivo).
+ */
+double VNS::penalizedCost(const Solution& sol) const {
+    double cost = sol.getTotalCost();
+    if (!penalizedCapacity) return cost;
+    for (const auto& route : sol.getRoutes()) cost += excessPenalty(route.getCurrentLoad());
+    return cost;
+}
+
+/*
+ * Descripción: Activa o desactiva la búsqueda con capacidad penalizada. La penalización
+ * inicial es la distancia máxima entre nodos dividida por la demanda máxima.
+ * Entrada: Activación, fracción objetivo de mínimos locales factibles.
+ * Salida: Ninguna.
+ */
+void VNS::setPenalizedCapacity(bool enabled, double targetFeasibleFraction) {
+    int limit = enabled ? (int)(MAX_LOAD_FACTOR * parserData->getCapacity())
+                        : parserData->getCapacity();
+    // Los movimientos memorizados por par de rutas se evaluaron con el límite anterior
+    if (enabled != penalizedCapacity || limit != loadLimit) routeSnapshot.clear();
+
+    penalizedCapacity = enabled;
+    targetFeasible    = targetFeasibleFraction;
+    loadLimit         = limit;
+    recentFeasible.clear();
+    if (!enabled) return;
+
+    int dimension = parserData->getDimension();
+    int maxDemand = 1, maxDist = 0;
+    for (int i = 1; i <= dimension; i++) {
+        maxDemand = max(maxDemand, parserData->getClients()[i].getDemand());
+        for (int j = i + 1; j <= dimension; j++) maxDist = max(maxDist, parserData->getDistance(i, j));
+    }
+    setCapacityPenalty(max(MIN_PENALTY, min(1000.0, (double)maxDist / maxDemand)));
+}
+
+/*
+ * Descripción: Fija la penalización por unidad de exceso de carga. Los mejores movimientos
+ * memorizados por par de rutas incluyen la penalización, así que se descartan si cambia.
+ * Entrada: Penalización.
+ * Salida: Ninguna.
+ */
+void VNS::setCapacityPenalty(double penalty) {
+    if (penalty == capacityPenalty) return;
+    capacityPenalty = penalty;
+    routeSnapshot.clear();
+}
+
+/*
+ * Descripción: Registra la factibilidad de un mínimo local y, cada PENALTY_WINDOW mínimos,
+ * ajusta la penalización para acercar la fracción factible a la fracción objetivo.
+ * Entrada: Si el mínimo local respeta la capacidad.
+ * Salida: Ninguna.
+ */
+void VNS::adaptPenalty(bool feasible) {
+    recentFeasible.push_back(feasible);
+    if ((int)recentFeasible.size() < PENALTY_WINDOW) return;
+
+    double fraction = (double)count(recentFeasible.begin(), recentFeasible.end(), 1) / recentFeasible.size();
+    recentFeasible.clear();
+    if (fraction < targetFeasible - 0.05)      setCapacityPenalty(min(MAX_PENALTY, capacityPenalty * 1.2));
+    else if (fraction > targetFeasible + 0.05) setCapacityPenalty(max(MIN_PENALTY, capacityPenalty * 0.85));
+}
+
+/*
+ * Descripción: Fase de reparación: repite el VND multiplicando la penalización por
+ * REPAIR_MULTIPLIER hasta que la solución respete la capacidad o se agoten REPAIR_ROUNDS
+ * rondas, y restaura la penalización original. Desde la segunda ronda se agrega una ruta
+ * vacía como destino, por si la flota actual no alcanza para la demanda.
+ * Entrada: Solución (se modifica).
+ * Salida: Booleano indicando si la solución quedó factible.
+ */
+bool VNS::repairCapacity(Solution& sol) {
+    if (totalExcess(sol) == 0) return true;
+
+    double basePenalty = capacityPenalty;
+    for (int round = 0; round < REPAIR_ROUNDS && totalExcess(sol) > 0; round++) {
+        setCapacityPenalty(capacityPenalty * REPAIR_MULTIPLIER);
+        if (round > 0) sol.addRoute(Route(parserData->getCapacity(), parserData));
+        variableNeighborhoodDescent(sol);
+    }
+    sol.removeEmptyRoutes();
+    setCapacityPenalty(basePenalty);
+    return totalExcess(sol) == 0;
+}
+
+/*
+ * Descripción: Búsqueda local sin agitación: 3-OPT y VND con la penalización vigente. En modo
+ * de capacidad penalizada la solución puede quedar infactible (no se repara).
+ * Entrada: Solución (se modifica), criterios de parada.
+ * Salida: Ninguna.
+ */
+void VNS::localSearch(Solution& sol, const StopCriteria& stop) {
+    activeStop = &stop;
+    sol = kopt.optimize(sol);
+    variableNeighborhoodDescent(sol);
+    activeStop = nullptr;
+}
+
+/*
+ * Descripción: Variante pública de la fase de reparación, acotada por los criterios de parada.
+ * Entrada: Solución (se modifica), criterios de parada.
+ * Salida: Booleano indicando si la solución quedó factible.
+ */
+bool VNS::repairCapacity(Solution& sol, const StopCriteria& stop) {
+    activeStop = &stop;
+    bool feasible = repairCapacity(sol);
+    activeStop = nullptr;
+    return feasible;
 }
 
 // ─────────────────────────────────────────────────────────────
@@ -337,150 +1463,372 @@ bool VNS::neighborhoodOrOpt(Solution& sol, int segLen) {
  * Descripción: Aplica una fase de agitación (Shaking) a la solución. Extrae aleatoriamente 
  * una cantidad determinada ('intensity') de clientes y los reinserta empleando heurística 
  * Greedy. Este mecanismo permite escapar de valles de óptimos locales profundos.
- * Entrada: Solución base actual, nivel de intensidad de la agitación, generador pseudo-aleatorio.
- * Salida: Nueva solución perturbada.
+ * La reinserción sólo evalúa las posiciones adyacentes a los vecinos cercanos del cliente
+ * (recorre todas las rutas únicamente si ninguna de ellas es factible), las cargas se
+ * mantienen de forma incremental y sólo se reconstruyen las rutas tocadas.
+ * Entrada: Solución a perturbar (se modifica in-place), nivel de intensidad de la agitación,
+ * generador pseudo-aleatorio.
+ * Salida: Ninguna.
  */
-Solution VNS::shake(const Solution& sol, int intensity, mt19937& rng) const {
+void VNS::shake(Solution& sol, int intensity, mt19937& rng) {
+    const auto& routes = sol.getRoutes();
+    const auto& clientData = parserData->getClients();
     int Q = parserData->getCapacity();
+    int numRoutes = routes.size();
+    int neighborsK = neighborListSize();
 
-    vector<vector<int>> paths;
-    for (const auto& route : sol.getRoutes())
-        paths.push_back(route.getPath());
-
-    int numRoutes = paths.size();
-
-    vector<pair<int,int>> allClients; 
+    shakeUnits.clear();
     for (int r = 0; r < numRoutes; r++) {
-        int routeSize = paths[r].size() - 2; 
+        int routeSize = routes[r].getPath().size() - 2; 
         if (routeSize > 1) {
             for (int i = 1; i <= routeSize; i++)
-                allClients.push_back({r, i});
+                shakeUnits.push_back({r, i});
         }
     }
 
-    if (allClients.empty()) return sol;
+    if (shakeUnits.empty()) return;
 
-    intensity = min(intensity, (int)allClients.size());
-
-    shuffle(allClients.begin(), allClients.end(), rng);
-    vector<int> extracted; 
+    intensity = min(intensity, (int)shakeUnits.size());
 
-    map<int, vector<int>> toRemoveByRoute;
-    for (int k = 0; k < intensity; k++)
-        toRemoveByRoute[allClients[k].first].push_back(allClients[k].second);
-
-    for (auto& [routeIdx, positions] : toRemoveByRoute) {
-        sort(positions.rbegin(), positions.rend()); 
-        for (int pos : positions) {
-            extracted.push_back(paths[routeIdx][pos]);
-            paths[routeIdx].erase(paths[routeIdx].begin() + pos);
+    // Fisher-Yates parcial: sólo se sortean los 'intensity' primeros
+    for (int k = 0; k < intensity; k++) {
+        uniform_int_distribution<int> pick(k, (int)shakeUnits.size() - 1);
+        swap(shakeUnits[k], shakeUnits[pick(rng)]);
+    }
+    sort(shakeUnits.begin(), shakeUnits.begin() + intensity,
+         [](const pair<int,int>& a, const pair<int,int>& b) {
+             return a.first != b.first ? a.first < b.first : a.second > b.second;
+         });
+
+    // Sólo las rutas tocadas se copian a un buffer de trabajo
+    buildLocationMap(sol);
+    shakeLoads.resize(numRoutes);
+    for (int r = 0; r < numRoutes; r++) shakeLoads[r] = routes[r].getCurrentLoad();
+    shakeWorking.assign(numRoutes, -1);
+    shakePaths.clear();
+
+    auto workingPath = [&](int r) -> vector<int>& {
+        if (shakeWorking[r] == -1) {
+            shakeWorking[r] = shakePaths.size();
+            shakePaths.push_back(routes[r].getPath());
+        }
+        return shakePaths[shakeWorking[r]];
+    };
+    auto pathOf = [&](int r) -> const vector<int>& {
+        return shakeWorking[r] == -1 ? routes[r].getPath() : shakePaths[shakeWorking[r]];
+    };
+    auto refreshPositions = [&](int r) {
+        const vector<int>& path = pathOf(r);
+        for (int i = 1; i < (int)path.size() - 1; i++) {
+            routeOf[path[i]] = r;
+            posOf[path[i]]   = i;
         }
+    };
+
+    // Posiciones en orden descendente por ruta: borrar no desplaza las pendientes
+    vector<int> extracted; 
+    for (int k = 0; k < intensity; k++) {
+        auto [r, pos] = shakeUnits[k];
+        vector<int>& path = workingPath(r);
+        int clientId = path[pos];
+        extracted.push_back(clientId);
+        path.erase(path.begin() + pos);
+        shakeLoads[r]     -= clientData[clientId].getDemand();
+        routeOf[clientId]  = -1;
+        if (k + 1 == intensity || shakeUnits[k + 1].first != r) refreshPositions(r);
     }
 
     for (int clientId : extracted) {
-        int demand = parserData->getClients()[clientId].getDemand();
+        int demand = clientData[clientId].getDemand();
         int bestDelta = INT_MAX;
         int bestRoute = -1;
         int bestPos   = -1;
 
-        for (int r = 0; r < numRoutes; r++) {
-            int load = 0;
-            for (int node : paths[r])
-                if (node != 1) load += parserData->getClients()[node].getDemand();
-
-            if (load + demand > Q) continue;
+        auto tryPosition = [&](int r, int i) {
+            const vector<int>& path = pathOf(r);
+            int delta = insertionCost(path[i - 1], clientId, path[i]);
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestRoute = r;
+                bestPos   = i;
+            }
+        };
+
+        // Antes y después de cada vecino cercano ya ruteado
+        const auto& neighbors = parserData->getSortedNeighbors(clientId);
+        int limit = min(neighborsK, (int)neighbors.size());
+        for (int n = 0; n < limit; n++) {
+            int v = neighbors[n].id;
+            if (v == 1 || routeOf[v] == -1) continue;
+            int r = routeOf[v];
+            if (shakeLoads[r] + demand > Q) continue;
+            tryPosition(r, posOf[v]);
+            tryPosition(r, posOf[v] + 1);
+        }
 
-            int pathSize = paths[r].size();
-            for (int i = 1; i < pathSize; i++) {
-                int prev = paths[r][i - 1];
-                int next = paths[r][i];
-                int delta = parserData->getDistance(prev, clientId)
-                          + parserData->getDistance(clientId, next)
-                          - parserData->getDistance(prev, next);
-                if (delta < bestDelta) {
-                    bestDelta = delta;
-                    bestRoute = r;
-                    bestPos   = i;
-                }
+        if (bestRoute == -1) {
+            for (int r = 0; r < (int)shakeLoads.size(); r++) {
+                if (shakeLoads[r] + demand > Q) continue;
+                for (int i = 1; i < (int)pathOf(r).size(); i++) tryPosition(r, i);
             }
         }
 
         if (bestRoute != -1) {
-            paths[bestRoute].insert(paths[bestRoute].begin() + bestPos, clientId);
+            vector<int>& path = workingPath(bestRoute);
+            path.insert(path.begin() + bestPos, clientId);
         } else {
-            paths.push_back({1, clientId, 1});
-            numRoutes++;
+            bestRoute = shakeLoads.size();
+            shakeLoads.push_back(0);
+            shakeWorking.push_back(shakePaths.size());
+            shakePaths.push_back({1, clientId, 1});
         }
+        shakeLoads[bestRoute] += demand;
+        refreshPositions(bestRoute);
     }
 
-    Solution newSol(parserData);
-    for (const auto& path : paths) {
-        if (path.size() <= 2) continue; 
-        Route newRoute(Q, parserData);
-        for (int i = 1; i < (int)path.size() - 1; i++)
-            newRoute.addClient(path[i]);
-        newSol.addRoute(newRoute);
+    bool emptied = false;
+    for (int r = 0; r < (int)shakeWorking.size(); r++) {
+        if (shakeWorking[r] == -1) continue;
+        const vector<int>& path = shakePaths[shakeWorking[r]];
+        if (path.size() <= 2) emptied = true;
+        Route route(Q, parserData, path);
+        if (r < numRoutes) sol.replaceRoute(r, route);
+        else               sol.addRoute(route);
     }
-
-    return newSol;
+    if (emptied) sol.removeEmptyRoutes();
 }
 
 /*
- * Descripción: Función principal del algoritmo VNS. Alterna sistemáticamente entre las vecindades 
- * iterando bajo el esquema Variable Neighborhood Descent (VND). Emplea 3-OPT como post-optimización 
- * y mecanismos de Shaking si se estanca.
- * Entrada: Solución factible inicial, cantidad máxima de iteraciones sin mejora permitidas.
- * Salida: Mejor solución local/global encontrada.
+ * Descripción: Indica si algún criterio de parada de la llamada en curso se cumplió.
+ * Entrada: Costo de la mejor solución actual.
+ * Salida: Booleano.
  */
-Solution VNS::optimize(const Solution& initialSolution, int maxIter) {
-    KOpt kopt(parserData);
-    mt19937 rng(42); 
+bool VNS::stopRequested(double bestCost) const {
+    if (activeStop == nullptr) return false;
+    if (activeStop->targetCost > 0.0 && bestCost <= activeStop->targetCost) return true;
+    if (activeStop->cancel != nullptr && activeStop->cancel->load(memory_order_relaxed)) return true;
+    if (sharedStop != nullptr && sharedStop->load(memory_order_relaxed)) return true;
+    return Clock::now() >= activeStop->deadline;
+}
 
+/*
+ * Descripción: Bucle VNS + Shaking sobre una trayectoria. Si hay incumbente compartido, cada
+ * SYNC_INTERVAL iteraciones publica su mejor solución y, si quedó rezagada más de RESTART_GAP
+ * respecto del incumbente (o lleva media paciencia estancada frente a uno mejor), se reinicia
+ * desde él.
+ * Entrada: Mejor solución de la trayectoria (se actualiza), iteraciones sin mejora permitidas,
+ * incumbente compartido (nullptr en modo secuencial), callback de nueva mejor solución.
+ * Salida: Ninguna (modifica 'best').
+ */
+void VNS::searchTrajectory(Solution& best, int maxIter, SharedIncumbent* incumbent,
+                           const NewBestCallback& onNewBest) {
     const int K_MAX        = 5;   
-    const int MAX_ITER     = maxIter; 
     const int BASE_SHAKE   = 2;
 
-    // ── 1. Fase Inicial: VND sin perturbación ──
-    Solution best = kopt.optimize(initialSolution);
-    Solution current = best;
-
-    bool improved = true;
-    while (improved) {
-        improved = false;
-        if (neighborhoodRelocate(current)) { current = kopt.optimize(current); improved = true; continue; }
-        if (neighborhoodSwap(current))     { current = kopt.optimize(current); improved = true; continue; }
-        if (neighborhoodOrOpt(current, 2)) { current = kopt.optimize(current); improved = true; continue; }
-        if (neighborhoodOrOpt(current, 3)) { current = kopt.optimize(current); improved = true; continue; }
-    }
-    best = current;
-
-    // ── 2. Fase de Exploración: Loop VNS + Shaking ──
     int k       = 1;
     int noImproveCount = 0;
+    int iteration      = 0;
 
-    while (noImproveCount < MAX_ITER) {
+    while (noImproveCount < maxIter && !stopRequested(best.getTotalCost())) {
         int intensity = BASE_SHAKE + k;
-        Solution shaken = shake(best, intensity, rng);
-
-        Solution candidate = shaken;
-        improved = true;
-        while (improved) {
-            improved = false;
-            if (neighborhoodRelocate(candidate)) { candidate = kopt.optimize(candidate); improved = true; continue; }
-            if (neighborhoodSwap(candidate))     { candidate = kopt.optimize(candidate); improved = true; continue; }
-            if (neighborhoodOrOpt(candidate, 2)) { candidate = kopt.optimize(candidate); improved = true; continue; }
-            if (neighborhoodOrOpt(candidate, 3)) { candidate = kopt.optimize(candidate); improved = true; continue; }
+        Solution candidate = best;
+        shake(candidate, intensity, rng);
+        variableNeighborhoodDescent(candidate);
+
+        bool feasible = true;
+        if (penalizedCapacity) {
+            adaptPenalty(totalExcess(candidate) == 0);
+            feasible = repairCapacity(candidate);
         }
 
-        if (candidate.getTotalCost() < best.getTotalCost()) {
+        if (feasible && candidate.getTotalCost() < best.getTotalCost()) {
             best    = candidate;
             k       = 1;          
             noImproveCount = 0;
+            if (onNewBest) onNewBest(best);
         } else {
             k = (k % K_MAX) + 1;  
             noImproveCount++;
         }
+
+        if (incumbent != nullptr && ++iteration % SYNC_INTERVAL == 0) {
+            publishIncumbent(incumbent, best);
+            double cost = incumbent->cost.load(memory_order_acquire);
+            if (cost < best.getTotalCost() &&
+                (best.getTotalCost() > cost * (1.0 + RESTART_GAP) || 2 * noImproveCount >= maxIter)) {
+                shared_ptr<const Solution> shared;
+                {
+                    lock_guard<mutex> lock(incumbent->mutex);
+                    shared = incumbent->solution;
+                }
+                best = *shared;
+                k    = 1;
+                noImproveCount = 0;
+            }
+        }
+    }
+}
+
+/*
+ * Descripción: Publica una solución en el incumbente compartido si lo mejora. Las candidatas
+ * que no mejoran el costo atómico se descartan sin bloquear; las demás se copian fuera de la
+ * sección crítica y se instalan bajo el mutex, revalidando el costo.
+ * Entrada: Incumbente compartido, solución candidata.
+ * Salida: Booleano indicando si la solución quedó publicada.
+ */
+bool VNS::publishIncumbent(SharedIncumbent* incumbent, const Solution& sol) {
+    if (sol.getTotalCost() >= incumbent->cost.load(memory_order_acquire)) return false;
+
+    shared_ptr<const Solution> candidate = make_shared<const Solution>(sol);
+    lock_guard<mutex> lock(incumbent->mutex);
+    if (sol.getTotalCost() >= incumbent->cost.load(memory_order_relaxed)) return false;
+    incumbent->solution = move(candidate);
+    incumbent->cost.store(sol.getTotalCost(), memory_order_release);
+    return true;
+}
+
+/*
+ * Descripción: Define cuántas trayectorias VNS corren en paralelo en optimize().
+ * Entrada: Número de hilos (1 = secuencial).
+ * Salida: Ninguna.
+ */
+void VNS::setNumThreads(int threads) {
+    threads = max(1, threads);
+    if (threads == numThreads) return;
+    numThreads = threads;
+    pool.reset();
+    workers.clear();
+}
+
+/*
+ * Descripción: Crea (la primera vez) el pool y una VNS por trabajador, y les copia la
+ * configuración actual.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void VNS::prepareWorkers() {
+    if (!pool) {
+        pool.reset(new ThreadPool(numThreads));
+        for (int w = 0; w < pool->size(); ++w) {
+            workers.emplace_back(new VNS(parserData));
+        }
+    }
+    for (auto& worker : workers) {
+        worker->setIntraRouteMode(intraMode, intraPolicy);
+        worker->granularity   = granularity;
+        worker->vndOrder      = vndOrder;
+        worker->sampleSize    = sampleSize;
+        worker->pruningTolerance = pruningTolerance;
+        worker->adaptiveOrder = adaptiveOrder;
+        if (worker->penalizedCapacity != penalizedCapacity || worker->loadLimit != loadLimit)
+            worker->routeSnapshot.clear();
+        worker->penalizedCapacity = penalizedCapacity;
+        worker->loadLimit         = loadLimit;
+        worker->targetFeasible    = targetFeasible;
+        worker->setCapacityPenalty(capacityPenalty);
+        copy(policies, policies + NUM_NEIGHBORHOODS, worker->policies);
+    }
+}
+
+/*
+ * Descripción: Función principal del algoritmo VNS. Alterna sistemáticamente entre las vecindades 
+ * iterando bajo el esquema Variable Neighborhood Descent (VND). Emplea 3-OPT como post-optimización 
+ * y mecanismos de Shaking si se estanca. Usa el límite de tiempo de setTimeLimit() si lo hay.
+ * Entrada: Solución factible inicial, cantidad máxima de iteraciones sin mejora permitidas.
+ * Salida: Mejor solución local/global encontrada.
+ */
+Solution VNS::optimize(const Solution& initialSolution, int maxIter) {
+    StopCriteria stop;
+    if (timeLimit > 0.0) {
+        stop.deadline = Clock::now() + chrono::duration_cast<Clock::duration>(
+                                           chrono::duration<double>(timeLimit));
+    }
+    return optimize(initialSolution, maxIter, stop);
+}
+
+/*
+ * Descripción: Variante de optimize() acotada por plazo, costo objetivo y bandera de
+ * cancelación, que avisa de cada nueva mejor solución. Con varios hilos lanza una
+ * trayectoria por hilo desde el mínimo local inicial, con semillas distintas y un incumbente
+ * compartido; cada mejora se publica de inmediato y el callback se serializa.
+ * Entrada: Solución factible inicial, iteraciones sin mejora permitidas, criterios de parada,
+ * callback de nueva mejor solución (opcional).
+ * Salida: Mejor solución encontrada.
+ */
+Solution VNS::optimize(const Solution& initialSolution, int maxIter, const StopCriteria& stop,
+                       const NewBestCallback& onNewBest) {
+    rng.seed(seed);
+    activeStop = &stop;
+
+    // ── 1. Fase Inicial: VND sin perturbación ──
+    Solution best = kopt.optimize(initialSolution);
+    variableNeighborhoodDescent(best);
+    if (penalizedCapacity && !repairCapacity(best)) best = initialSolution;
+    if (onNewBest && best.getTotalCost() < initialSolution.getTotalCost()) onNewBest(best);
+
+    // ── 2. Fase de Exploración: Loop VNS + Shaking ──
+    if (numThreads == 1) {
+        searchTrajectory(best, maxIter, nullptr, onNewBest);
+        activeStop = nullptr;
+        return best;
+    }
+
+    prepareWorkers();
+    for (auto& worker : workers) {
+        worker->movesApplied = 0;
+        worker->prunedPairs  = 0;
+        worker->resetStats();
+    }
+
+    SharedIncumbent incumbent;
+    incumbent.solution = make_shared<const Solution>(best);
+    incumbent.cost     = best.getTotalCost();
+    atomic<bool> targetReached(false);
+    mutex        callbackMutex;
+    double       reportedCost = best.getTotalCost();
+
+    NewBestCallback publish = [&](const Solution& sol) {
+        if (!publishIncumbent(&incumbent, sol)) return;
+        if (stop.targetCost > 0.0 && sol.getTotalCost() <= stop.targetCost) targetReached = true;
+        if (!onNewBest) return;
+        lock_guard<mutex> lock(callbackMutex);
+        if (sol.getTotalCost() < reportedCost) {
+            reportedCost = sol.getTotalCost();
+            onNewBest(sol);
+        }
+    };
+
+    pool->run(pool->size(), [&](int task, int worker) {
+        VNS& trajectoryVns = *workers[worker];
+        trajectoryVns.rng.seed(seed + task);
+        trajectoryVns.activeStop = &stop;
+        trajectoryVns.sharedStop = &targetReached;
+
+        Solution trajectory = best;
+        trajectoryVns.searchTrajectory(trajectory, maxIter, &incumbent, publish);
+        publish(trajectory);
+
+        trajectoryVns.activeStop = nullptr;
+        trajectoryVns.sharedStop = nullptr;
+    });
+
+    for (const auto& worker : workers) {
+        movesApplied += worker->movesApplied;
+        prunedPairs  += worker->prunedPairs;
+        for (int n = 0; n < NUM_NEIGHBORHOODS; n++) {
+            stats[n].evaluations  += worker->stats[n].evaluations;
+            stats[n].improvements += worker->stats[n].improvements;
+            stats[n].totalGain    += worker->stats[n].totalGain;
+            stats[n].seconds      += worker->stats[n].seconds;
+        }
     }
+    activeStop = nullptr;
+    return *incumbent.solution;
+}
 
-    return best;
-}
\ No newline at end of file
+/*
+ * Descripción: Destructor de la clase.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+VNS::~VNS() {}
\ No newline at end of file
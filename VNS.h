@@ -5,23 +5,359 @@
 #include "Solution.h"
 #include "Route.h"
 #include "KOpt.h"
+#include "ThreadPool.h"
 #include <random>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <functional>
+
+/*
+ * Estructura CircleSector
+ * Descripción: Sector polar (alrededor de la bodega) que cubre los clientes de una ruta.
+ * Los ángulos se discretizan en [0, 65536). Permite descartar en O(1) pares de rutas
+ * geográficamente separados.
+ */
+struct CircleSector {
+    int start = 0;
+    int end   = 0;
+
+    static int positiveMod(int angle) { return ((angle % 65536) + 65536) % 65536; }
+
+    void initialize(int angle) { start = angle; end = angle; }
+
+    bool isEnclosed(int angle) const {
+        return positiveMod(angle - start) <= positiveMod(end - start);
+    }
+
+    // Extiende el sector por el lado más cercano para cubrir 'angle'
+    void extend(int angle) {
+        if (isEnclosed(angle)) return;
+        if (positiveMod(angle - end) <= positiveMod(start - angle)) end = angle;
+        else                                                        start = angle;
+    }
+
+    // 'tolerance' ensancha el sector 'a' por ambos lados antes de comparar
+    static bool overlap(const CircleSector& a, const CircleSector& b, int tolerance = 0) {
+        int widthA = positiveMod(a.end - a.start) + 2 * tolerance;
+        if (widthA >= 65536) return true;
+        int startA = a.start - tolerance;
+        return positiveMod(b.start - startA) <= widthA
+            || positiveMod(startA - b.start) <= positiveMod(b.end - b.start);
+    }
+};
 
 /*
  * Clase VNS
  * Descripción: Implementa la metaheurística Variable Neighborhood Search (VNS) para el CVRP.
- * Aplica sistemáticamente estructuras de vecindad inter-ruta (Relocate, Swap, Or-Opt)
- * combinadas con optimización intra-ruta (3-OPT) y fases de agitación (Shaking) 
- * para escapar de óptimos locales.
+ * Aplica sistemáticamente estructuras de vecindad inter-ruta (Relocate, Swap, Or-Opt,
+ * 2-OPT*, CROSS-Exchange, SWAP*, cadenas de expulsión) combinadas con optimización
+ * intra-ruta (3-OPT) y fases de agitación (Shaking) para escapar de óptimos locales.
+ * Opcionalmente las vecindades pueden restringirse a los vecinos más cercanos de cada
+ * cliente (granularidad) para instancias grandes.
+ * Con varios hilos, cada uno recorre una trayectoria VNS independiente (semilla propia) y
+ * comparten la mejor solución a través de un incumbente común.
  */
 class VNS {
 public:
+    /*
+     * Enum SearchPolicy
+     * Descripción: Cómo se explora cada vecindad antes de aplicar un movimiento.
+     *  - BestImprovement:  recorre la vecindad completa y aplica el mejor movimiento.
+     *  - FirstImprovement: recorre en orden aleatorio y aplica el primer movimiento mejorador.
+     *  - Sampled:          recorre en orden aleatorio por bloques de 'sampleSize' unidades y
+     *                      aplica el mejor movimiento del primer bloque que contenga alguno.
+     */
+    enum class SearchPolicy { BestImprovement, FirstImprovement, Sampled };
+
+    // Vecindades inter-ruta disponibles para el VND
+    enum Neighborhood { Relocate, OrOpt2, OrOpt3, Swap, TwoOptStar, CrossExchange, SwapStar, EjectionChain,
+                        NUM_NEIGHBORHOODS };
+
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+     * Estructura StopCriteria
+     * Descripción: Criterios de parada adicionales a maxIter. Se revisan entre iteraciones y
+     * entre pasos del VND, de modo que la latencia por sobre el plazo es a lo más un paso.
+     *  - deadline:   instante de reloj en que se detiene la búsqueda.
+     *  - targetCost: se detiene al alcanzar un costo menor o igual (0 = sin objetivo).
+     *  - cancel:     bandera cooperativa que otro hilo puede activar (nullptr = ninguna).
+     */
+    struct StopCriteria {
+        Clock::time_point        deadline   = Clock::time_point::max();
+        double                   targetCost = 0.0;
+        const std::atomic<bool>* cancel     = nullptr;
+    };
+
+    /*
+     * Estructura NeighborhoodStats
+     * Descripción: Contadores acumulados de una vecindad dentro del VND.
+     */
+    struct NeighborhoodStats {
+        long long evaluations  = 0;     // veces que se exploró la vecindad
+        long long improvements = 0;     // exploraciones que aplicaron un movimiento
+        double    totalGain    = 0.0;   // reducción acumulada del costo
+        double    seconds      = 0.0;   // tiempo total de exploración
+    };
+
+    // Se invoca con cada nueva mejor solución (en modo paralelo, serializado y en orden de costo)
+    typedef std::function<void(const Solution&)> NewBestCallback;
+
     explicit VNS(const Parser* parser);
 
     Solution optimize(const Solution& initialSolution, int maxIter = 100);
 
+    Solution optimize(const Solution& initialSolution, int maxIter, const StopCriteria& stop,
+                      const NewBestCallback& onNewBest = NewBestCallback());
+
+    ~VNS();
+
+    void setIntraRouteMode(KOpt::Mode mode, KOpt::Policy policy = KOpt::Policy::BestImprovement) {
+        kopt.setMode(mode);
+        kopt.setPolicy(policy);
+        intraMode   = mode;
+        intraPolicy = policy;
+    }
+
+    // Semilla base; con varios hilos la trayectoria t usa seed + t
+    void setSeed(unsigned int s) { seed = s; }
+
+    // Número de trayectorias VNS simultáneas (1 = secuencial)
+    void setNumThreads(int threads);
+
+    // Hilos que reparten la evaluación de los pares de rutas dentro de cada paso del VND
+    // (Relocate, Or-Opt y Swap exhaustivos con Best-Improvement). El resultado no cambia.
+    void setEvaluationThreads(int threads);
+
+    // Límite de tiempo de reloj en segundos (0 = sin límite, sólo maxIter)
+    void setTimeLimit(double seconds) { timeLimit = seconds; }
+
+    // k > 0: las vecindades sólo evalúan movimientos que crean una arista hacia uno de
+    // los k vecinos más cercanos del cliente (vecindades granulares). 0 = exhaustivo.
+    void setGranularity(int k) { granularity = k; }
+
+    void setSearchPolicy(SearchPolicy policy, int sample = 16);
+    void setSearchPolicy(Neighborhood neighborhood, SearchPolicy policy);
+
+    long long getMovesApplied() const { return movesApplied; }
+
+    // Por defecto el VND usa las vecindades clásicas; 2-OPT*, CROSS, SWAP* y las cadenas de
+    // expulsión (útiles en instancias de capacidad ajustada) se activan aquí
+    void setNeighborhoodOrder(const std::vector<Neighborhood>& order) { vndOrder = order; }
+
+    // En modo exhaustivo, Relocate, Or-Opt y Swap sólo evalúan pares de rutas cuyos sectores
+    // polares (ensanchados en 'toleranceDegrees') se solapan
+    void setSectorPruning(bool enabled, double toleranceDegrees = 15.0);
+    long long getPrunedPairs() const { return prunedPairs; }
+
+    // Reordena las vecindades del VND por ganancia reciente por segundo (promedio exponencial)
+    void setAdaptiveOrder(bool enabled) { adaptiveOrder = enabled; }
+
+    const NeighborhoodStats& getStats(Neighborhood neighborhood) const { return stats[neighborhood]; }
+    void resetStats();
+
+    // Capacidad penalizada: las rutas pueden cargar hasta MAX_LOAD_FACTOR * Q pagando una
+    // penalización por unidad de exceso, ajustada para que una fracción 'targetFeasible' de
+    // los mínimos locales sea factible. Cada mínimo local infactible se repara antes de
+    // compararse con la mejor solución, que siempre es factible.
+    void setPenalizedCapacity(bool enabled, double targetFeasible = 0.2);
+    void setCapacityPenalty(double penalty);
+    double getCapacityPenalty() const { return capacityPenalty; }
+    int  totalExcess(const Solution& sol) const;
+
+    // 3-OPT + VND sin agitación ni reparación (la solución puede quedar infactible)
+    void localSearch(Solution& sol, const StopCriteria& stop);
+
+    // Fase de reparación de la capacidad penalizada; retorna si la solución quedó factible
+    bool repairCapacity(Solution& sol, const StopCriteria& stop);
+
 private:
     const Parser* parserData;
+    KOpt          kopt;
+    int           granularity = 0;
+    std::mt19937  rng;
+    unsigned int  seed        = 42;
+    KOpt::Mode    intraMode   = KOpt::Mode::ThreeOpt;
+    KOpt::Policy  intraPolicy = KOpt::Policy::BestImprovement;
+
+    // ── Multi-arranque paralelo: una VNS por trabajador e incumbente compartido ──
+    int                               numThreads = 1;
+    double                            timeLimit  = 0.0;
+    std::unique_ptr<ThreadPool>       pool;
+    std::vector<std::unique_ptr<VNS>> workers;
+
+    static constexpr int    SYNC_INTERVAL = 10;      // iteraciones entre consultas al incumbente
+    static constexpr double RESTART_GAP   = 0.01;    // brecha relativa que fuerza el reinicio
+
+    void prepareWorkers();
+
+    // ── Criterios de parada de la llamada en curso ──
+    const StopCriteria*      activeStop = nullptr;
+    const std::atomic<bool>* sharedStop = nullptr;   // bandera común de las trayectorias paralelas
+
+    bool stopRequested(double bestCost) const;
+
+    // Incumbente compartido por las trayectorias. No es lock-free: la solución se publica y se
+    // lee bajo el mutex; el costo atómico sólo permite descartar sin bloqueo las candidatas que
+    // no lo mejoran y decidir si vale la pena copiarlo.
+    struct SharedIncumbent {
+        std::mutex                      mutex;
+        std::shared_ptr<const Solution> solution;
+        std::atomic<double>             cost{ 0.0 };
+    };
+
+    void searchTrajectory(Solution& best, int maxIter, SharedIncumbent* incumbent,
+                          const NewBestCallback& onNewBest);
+
+    static bool publishIncumbent(SharedIncumbent* incumbent, const Solution& sol);
+
+    std::vector<Neighborhood> vndOrder = { Relocate, Swap, OrOpt2, OrOpt3 };
+
+    static constexpr int DEFAULT_GRANULARITY = 20;  // vecinos de 2-OPT* y CROSS en modo exhaustivo
+    static constexpr int CROSS_MAX_SEGMENT   = 3;
+    static constexpr int EJECTION_MAX_DEPTH  = 3;   // capas de la cadena (movimientos encadenados)
+
+    // ── Cadenas de expulsión: etiquetas del camino más corto por capas ──
+    struct ChainLabel {
+        int client;        // cliente que sale de 'route' en este eslabón
+        int route;         // ruta de la que sale (y en la que entra el cliente del eslabón previo)
+        int delta;         // variación acumulada del costo
+        int pred;          // índice de la etiqueta previa en la capa anterior (-1 en la capa 0)
+        int insertAfter;   // nodo de 'route' tras el que entra el cliente previo
+    };
+    std::vector<ChainLabel> chainLayers[EJECTION_MAX_DEPTH];
+    std::vector<int>        chainLabelOf;     // etiqueta de cada cliente en la capa en construcción
+
+    // ── Estadísticas y orden adaptativo de las vecindades ──
+    NeighborhoodStats stats[NUM_NEIGHBORHOODS];
+    bool              adaptiveOrder = false;
+    double            recentGain[NUM_NEIGHBORHOODS]    = {};
+    double            recentSeconds[NUM_NEIGHBORHOODS] = {};
+
+    static constexpr double ADAPTIVE_DECAY = 0.8;   // peso del historial en el promedio exponencial
+
+    void recordStats(Neighborhood neighborhood, bool applied, double gain, double seconds);
+
+    void reorderNeighborhoods();
+
+    // ── Capacidad penalizada ──
+    bool              penalizedCapacity = false;
+    double            capacityPenalty   = 1.0;    // costo por unidad de exceso de carga
+    int               loadLimit;                  // carga máxima admitida en una ruta
+    double            targetFeasible    = 0.2;
+    std::vector<char> recentFeasible;             // factibilidad de los últimos mínimos locales
+
+    static constexpr double MAX_LOAD_FACTOR   = 1.5;
+    static constexpr int    PENALTY_WINDOW    = 20;     // mínimos locales entre ajustes
+    static constexpr double MIN_PENALTY       = 0.1;
+    static constexpr double MAX_PENALTY       = 100000.0;
+    static constexpr int    REPAIR_ROUNDS     = 3;
+    static constexpr double REPAIR_MULTIPLIER = 10.0;
+
+    int    excessPenalty(int load) const;
+
+    int    loadPenaltyDelta(int oldLoad, int newLoad) const;
+
+    double penalizedCost(const Solution& sol) const;
+
+    void   adaptPenalty(bool feasible);
+
+    bool   repairCapacity(Solution& sol);
+
+    // ── Políticas de exploración ──
+    SearchPolicy  policies[NUM_NEIGHBORHOODS] = { SearchPolicy::BestImprovement, SearchPolicy::BestImprovement,
+                                                  SearchPolicy::BestImprovement, SearchPolicy::BestImprovement,
+                                                  SearchPolicy::BestImprovement, SearchPolicy::BestImprovement,
+                                                  SearchPolicy::BestImprovement, SearchPolicy::BestImprovement };
+    int           sampleSize   = 16;
+    long long     movesApplied = 0;
+    long long     prunedPairs  = 0;   // pares de rutas descartados por la poda de sectores
+    std::vector<std::pair<int,int>> scanUnits;   // clientes (ruta, posición) o pares de rutas
+    std::vector<int>                scanOrder;   // orden de recorrido de scanUnits
+
+    int  scanChunk(SearchPolicy policy) const;
+
+    void shuffleScanOrder(SearchPolicy policy);
+
+    void buildScanUnits(const Solution& sol, int segLen, SearchPolicy policy);
+
+    int buildScanPairs(int numRoutes, bool symmetric, SearchPolicy policy, int sectorTolerance = -1);
+
+    // ── Estructuras auxiliares de las vecindades granulares ──
+    std::vector<int>                routeOf;     // ruta de cada cliente
+    std::vector<int>                posOf;       // posición de cada cliente en su ruta
+    std::vector<std::pair<int,int>> candidates;  // (ruta, posición) a evaluar
+    std::vector<std::vector<int>>   prefixLoad;  // carga acumulada de cada ruta hasta cada posición
+
+    // ── Caché del mejor movimiento por par de rutas (whenLastModified) ──
+    struct PairMove {
+        long long evaluatedAt = -1;  // reloj al evaluar el par
+        int       delta       = 0;   // mejor variación encontrada (0 = sin mejora)
+        int       from        = -1;  // posición en la primera ruta
+        int       to          = -1;  // posición en la segunda ruta
+        int       fromAfter   = -1;  // SWAP*: nodo de la primera ruta tras el que entra el cliente de la segunda
+        int       toAfter     = -1;  // SWAP*: nodo de la segunda ruta tras el que entra el cliente de la primera
+    };
+    enum MoveCache { CACHE_RELOCATE, CACHE_OROPT2, CACHE_OROPT3, CACHE_SWAP, CACHE_SWAPSTAR, NUM_MOVE_CACHES };
+
+    // ── SWAP*: tres mejores posiciones de inserción de cada cliente en cada ruta ──
+    struct InsertionTop3 {
+        long long evaluatedAt = -1;
+        int       cost[3];
+        int       after[3];     // nodo tras el que se inserta (-1 = posición vacía)
+    };
+    std::vector<InsertionTop3>  insertionCache;   // índice ruta * (dimensión + 1) + cliente
+    std::vector<int>            polarAngle;       // ángulo de cada cliente respecto de la bodega
+    std::vector<CircleSector>   routeSectors;     // se actualizan junto con lastModified
+    int                         pruningTolerance = -1;   // en unidades de ángulo; -1 = sin poda
+
+    std::vector<std::vector<int>> routeSnapshot;            // rutas vistas en la última llamada
+    std::vector<long long>        lastModified;             // reloj del último cambio de cada ruta
+    long long                     moveClock = 0;
+    std::vector<PairMove>         pairCache[NUM_MOVE_CACHES]; // índice r1 * numRutas + r2
+
+    void syncModifications(const Solution& sol);
+
+    bool isPairCurrent(const PairMove& move, int r1, int r2) const;
+
+    void evaluateSegmentPair(const Solution& sol, int segLen, int r1, int r2, PairMove& move) const;
+
+    void evaluateSwapPair(const Solution& sol, int r1, int r2, PairMove& move) const;
+
+    void evaluateSwapStarPair(const Solution& sol, int r1, int r2, PairMove& move);
+
+    // ── Evaluación paralela del espacio de pares de rutas (Best-Improvement exhaustivo) ──
+    int                             evalThreads = 1;
+    std::unique_ptr<ThreadPool>     evalPool;
+    std::vector<std::pair<int,int>> blockBest;    // (delta, índice en scanOrder) de cada bloque
+
+    static constexpr int PARALLEL_MIN_PAIRS  = 64;   // bajo esto no compensa repartir
+    static constexpr int BLOCKS_PER_THREAD   = 4;
+
+    bool parallelScan(SearchPolicy policy) const;
+
+    int  parallelPairScan(const Solution& sol, MoveCache which, int segLen);
+
+    const InsertionTop3& bestInsertions(const Solution& sol, int client, int route);
+
+    void updateRouteSector(int route, const std::vector<int>& path);
+
+    int segmentMoveDelta(const std::vector<int>& path1, int i, int segLen,
+                         const std::vector<int>& path2, int j) const;
+
+    int swapDelta(const std::vector<int>& path1, int i, const std::vector<int>& path2, int j) const;
+
+    void buildLocationMap(const Solution& sol);
+
+    void buildPrefixLoads(const Solution& sol);
+
+    int neighborListSize() const;
+
+    void insertionCandidates(const Solution& sol, int first, int last, int excludedRoute);
+
+    void swapCandidates(const Solution& sol, int client, int clientRoute);
 
     bool neighborhoodRelocate(Solution& sol);
 
@@ -29,7 +365,27 @@ private:
 
     bool neighborhoodOrOpt(Solution& sol, int segLen);
 
-    Solution shake(const Solution& sol, int intensity, std::mt19937& rng) const;
+    bool neighborhoodTwoOptStar(Solution& sol);
+
+    bool neighborhoodCrossExchange(Solution& sol);
+
+    bool neighborhoodSwapStar(Solution& sol);
+
+    bool neighborhoodEjectionChain(Solution& sol);
+
+    bool chainUsesRoute(int layer, int label, int route) const;
+
+    bool applyNeighborhood(Neighborhood neighborhood, Solution& sol);
+
+    void variableNeighborhoodDescent(Solution& sol);
+
+    // ── Buffers de la agitación ──
+    std::vector<std::pair<int,int>> shakeUnits;    // clientes (ruta, posición) extraíbles
+    std::vector<int>                shakeLoads;    // carga de cada ruta durante la agitación
+    std::vector<int>                shakeWorking;  // índice en shakePaths de cada ruta tocada (-1 = intacta)
+    std::vector<std::vector<int>>   shakePaths;
+
+    void shake(Solution& sol, int intensity, std::mt19937& rng);
 
     int insertionCost(int prev, int clientId, int next) const;
 
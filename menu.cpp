@@ -200,6 +200,64 @@ void Menu::ejecutarMejorHeuristica() {
     actualizarMejorSolucion(finalSol, "ALNS+CBC");
 }
 
+/*
+ * Descripción: Ejecuta la metaheurística Hybrid Genetic Search (cruce OX + Split, con
+ * educación mediante las vecindades de VNS) partiendo de la solución de Clarke & Wright.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void Menu::ejecutarHGS() {
+    cout << "\n--- Ejecutando Hybrid Genetic Search (HGS) ---" << endl;
+    cout << "Usando limite de tiempo de " << tiempoLimiteGlobal << "s." << endl;
+    auto inicio = steady_clock::now();
+
+    GreedyBuilder builder(parserGlobal.get());
+    Solution cwSol = builder.buildSolution();
+
+    HGS hgs(parserGlobal.get());
+    Solution finalSol = hgs.optimize(cwSol, tiempoLimiteGlobal);
+
+    double tiempo = duration<double>(steady_clock::now() - inicio).count();
+
+    cout << "\n>> Costo final HGS: " << finalSol.getTotalCost() << endl;
+    finalSol.print();
+
+    double gapCW = 100.0 * (cwSol.getTotalCost() - finalSol.getTotalCost()) / cwSol.getTotalCost();
+    cout << ">> Mejora sobre inicial (CW): " << gapCW << "%" << endl;
+
+    reportarTiempo(tiempo);
+    actualizarMejorSolucion(finalSol, "HGS");
+}
+
+/*
+ * Descripción: Ejecuta la búsqueda tabú granular partiendo de la solución de Clarke & Wright.
+ * Entrada: Ninguna.
+ * Salida: Ninguna.
+ */
+void Menu::ejecutarTabu() {
+    cout << "\n--- Ejecutando Busqueda Tabu Granular ---" << endl;
+    cout << "Usando limite de tiempo de " << tiempoLimiteGlobal << "s." << endl;
+    auto inicio = steady_clock::now();
+
+    GreedyBuilder builder(parserGlobal.get());
+    Solution cwSol = builder.buildSolution();
+
+    TabuSearch tabu(parserGlobal.get());
+    Solution finalSol = tabu.optimize(cwSol, tiempoLimiteGlobal);
+
+    double tiempo = duration<double>(steady_clock::now() - inicio).count();
+
+    cout << "\n>> Costo final Tabu: " << finalSol.getTotalCost()
+         << " (" << tabu.getIterations() << " iteraciones)" << endl;
+    finalSol.print();
+
+    double gapCW = 100.0 * (cwSol.getTotalCost() - finalSol.getTotalCost()) / cwSol.getTotalCost();
+    cout << ">> Mejora sobre inicial (CW): " << gapCW << "%" << endl;
+
+    reportarTiempo(tiempo);
+    actualizarMejorSolucion(finalSol, "Busqueda Tabu");
+}
+
 /*
  * Descripción: Solicita al usuario ingresar un esquema de rutas por teclado,
  * validando estructuralmente la entrada y evaluando la función objetivo resultante.
@@ -274,9 +332,11 @@ void Menu::inicializar() {
         cout << "2. Resolucion mediante Heuristica 3-OPT" << endl;
         cout << "3. Resolucion mediante Metodo Exacto Branch & Bound (CLP)" << endl;
         cout << "4. Resolucion mediante Mejor Heuristica (ALNS + CBC)" << endl;
-        cout << "5. Ingreso de Ruteo Manual y calculo de costo" << endl;
-        cout << "6. Ajustar Limite de Tiempo Global (Actual: " << tiempoLimiteGlobal << "s)" << endl;
-        cout << "7. Salir" << endl;
+        cout << "5. Resolucion mediante Hybrid Genetic Search (HGS)" << endl;
+        cout << "6. Resolucion mediante Busqueda Tabu Granular" << endl;
+        cout << "7. Ingreso de Ruteo Manual y calculo de costo" << endl;
+        cout << "8. Ajustar Limite de Tiempo Global (Actual: " << tiempoLimiteGlobal << "s)" << endl;
+        cout << "9. Salir" << endl;
         cout << "\nSeleccione una opcion: ";
         
         cin >> opcion;
@@ -297,13 +357,21 @@ void Menu::inicializar() {
             ejecutarMejorHeuristica();
         } 
         else if (opcion == "5") {
+            if (!instanciaCargada) { cout << ">> Error: Debe cargar una instancia primero.\n"; continue; }
+            ejecutarHGS();
+        } 
+        else if (opcion == "6") {
+            if (!instanciaCargada) { cout << ">> Error: Debe cargar una instancia primero.\n"; continue; }
+            ejecutarTabu();
+        } 
+        else if (opcion == "7") {
             if (!instanciaCargada) { cout << ">> Error: Debe cargar una instancia primero (para conocer Z y Q).\n"; continue; }
             ingresoManual();
         } 
-        else if (opcion == "6") {
+        else if (opcion == "8") {
             configurarTiempo();
         } 
-        else if (opcion == "7") {
+        else if (opcion == "9") {
             cout << ">> Saliendo del sistema CVRP. ¡Hasta luego!" << endl;
             break;
         } 
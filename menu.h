@@ -15,6 +15,8 @@
 #include "BranchAndBound.h"
 #include "CbcSolver.h"
 #include "ALNS.h"
+#include "HGS.h"
+#include "TabuSearch.h"
 
 /*
  * Clase Menu
@@ -40,6 +42,8 @@ private:
     void ejecutar3OPT();
     void ejecutarBranchAndBound();
     void ejecutarMejorHeuristica();
+    void ejecutarHGS();
+    void ejecutarTabu();
     void ingresoManual();
 
 public:
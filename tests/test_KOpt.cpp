@@ -1,10 +1,61 @@
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
 #include "Parser.h"
 #include "GreedyBuilder.h"
 #include "KOpt.h"
+#include "Route.h"
 
 using namespace std;
 
+/*
+ * Descripción: Implementación original del 3-OPT (reconexión copiando los cuatro segmentos),
+ * usada como referencia para validar la versión que reconecta in-place.
+ * Entrada: Parser, secuencia de la ruta (con la bodega en ambos extremos).
+ * Salida: Ninguna (modifica la secuencia).
+ */
+void referenceThreeOpt(const Parser& parser, vector<int>& path) {
+    auto dist = [&](int u, int v) { return parser.getDistance(u, v); };
+    bool improvement = true;
+    while (improvement) {
+        improvement = false;
+        int n = path.size();
+        if (n < 6) break;
+        for (int i = 0; i <= n - 4 && !improvement; ++i) {
+            for (int j = i + 1; j <= n - 3 && !improvement; ++j) {
+                for (int k = j + 1; k <= n - 2 && !improvement; ++k) {
+                    int a = path[i], b = path[i+1], c = path[j], d = path[j+1], e = path[k], f = path[k+1];
+                    int d0 = dist(a, b) + dist(c, d) + dist(e, f);
+                    int options[8] = { d0,
+                        dist(a, c) + dist(b, d) + dist(e, f), dist(a, b) + dist(c, e) + dist(d, f),
+                        dist(a, c) + dist(b, e) + dist(d, f), dist(a, d) + dist(e, b) + dist(c, f),
+                        dist(a, d) + dist(e, c) + dist(b, f), dist(a, e) + dist(d, b) + dist(c, f),
+                        dist(a, e) + dist(d, c) + dist(b, f) };
+                    int bestOpt = 0, bestDelta = 0;
+                    for (int o = 1; o <= 7; ++o) {
+                        if (options[o] - d0 < bestDelta) { bestDelta = options[o] - d0; bestOpt = o; }
+                    }
+                    if (bestOpt == 0) continue;
+                    improvement = true;
+
+                    vector<int> S2(path.begin() + i + 1, path.begin() + j + 1);
+                    vector<int> S3(path.begin() + j + 1, path.begin() + k + 1);
+                    vector<int> S2r(S2.rbegin(), S2.rend()), S3r(S3.rbegin(), S3.rend());
+                    const vector<int>* first[8]  = { nullptr, &S2r, &S2, &S2r, &S3, &S3, &S3r, &S3r };
+                    const vector<int>* second[8] = { nullptr, &S3, &S3r, &S3r, &S2, &S2r, &S2, &S2r };
+
+                    vector<int> newPath(path.begin(), path.begin() + i + 1);
+                    newPath.insert(newPath.end(), first[bestOpt]->begin(), first[bestOpt]->end());
+                    newPath.insert(newPath.end(), second[bestOpt]->begin(), second[bestOpt]->end());
+                    newPath.insert(newPath.end(), path.begin() + k + 1, path.end());
+                    path = newPath;
+                }
+            }
+        }
+    }
+}
+
 int main() {
     cout << "--- Iniciando Test de Heuristica 3-OPT ---" << endl;
     
@@ -36,5 +87,127 @@ int main() {
         cout << "REPROBADA [ERROR]" << endl;
     }
 
+    // 4. Modo 2-OPT + Or-Opt (listas de vecinos + don't-look bits) con pulido 3-OPT
+    cout << "\nEjecutando 2-OPT + Or-Opt con pulido 3-OPT final..." << endl;
+    KOpt optimizadorRapido(&parser);
+    optimizadorRapido.setMode(KOpt::Mode::TwoOptOrOpt);
+    optimizadorRapido.setFinalThreeOpt(true);
+    Solution solucionRapida = optimizadorRapido.optimize(solucionInicial);
+
+    cout << "Costo 2-OPT + Or-Opt: " << solucionRapida.getTotalCost() << endl;
+    cout << "Validacion 2-OPT + Or-Opt: ";
+    if (solucionRapida.isValid() && solucionRapida.getTotalCost() <= solucionInicial.getTotalCost()) {
+        cout << "APROBADA [OK]" << endl;
+    } else {
+        cout << "REPROBADA [ERROR]" << endl;
+    }
+
+    // 5. Optimizacion paralela por ruta: debe coincidir exactamente con la secuencial
+    cout << "\nEjecutando 3-OPT paralelo (4 hilos)..." << endl;
+    KOpt optimizadorParalelo(&parser);
+    optimizadorParalelo.setNumThreads(4);
+    Solution solucionParalela = optimizadorParalelo.optimize(solucionInicial);
+
+    bool identica = solucionParalela.getRoutes().size() == solucionMejorada.getRoutes().size();
+    for (size_t r = 0; identica && r < solucionParalela.getRoutes().size(); ++r) {
+        identica = solucionParalela.getRoutes()[r].getPath() == solucionMejorada.getRoutes()[r].getPath();
+    }
+
+    cout << "Costo 3-OPT paralelo: " << solucionParalela.getTotalCost() << endl;
+    cout << "Validacion paralelo = secuencial: ";
+    if (identica && solucionParalela.isValid()) {
+        cout << "APROBADA [OK]" << endl;
+    } else {
+        cout << "REPROBADA [ERROR]" << endl;
+    }
+
+    // 6. Cache de rutas: re-optimizar una solucion ya pulida debe resolverse sin recalcular
+    long long aciertosPrevios = optimizador.getCacheHits();
+    Solution solucionRepetida = optimizador.optimize(solucionMejorada);
+    long long aciertos = optimizador.getCacheHits() - aciertosPrevios;
+
+    cout << "\nCache de rutas: " << aciertos << " aciertos de "
+         << solucionMejorada.getRoutes().size() << " rutas" << endl;
+    cout << "Validacion cache: ";
+    if (aciertos == (long long)solucionMejorada.getRoutes().size() &&
+        solucionRepetida.getTotalCost() == solucionMejorada.getTotalCost()) {
+        cout << "APROBADA [OK]" << endl;
+    } else {
+        cout << "REPROBADA [ERROR]" << endl;
+    }
+
+    // 7. DP exacto (Held-Karp) para rutas cortas: nunca peor que el 3-OPT
+    KOpt optimizadorExacto(&parser);
+    optimizadorExacto.setExactThreshold(12);
+    Solution solucionExacta = optimizadorExacto.optimize(solucionInicial);
+
+    cout << "\nCosto con DP exacto en rutas cortas: " << solucionExacta.getTotalCost() << endl;
+    cout << "Validacion DP exacto: ";
+    if (solucionExacta.isValid() && solucionExacta.getTotalCost() <= solucionMejorada.getTotalCost()) {
+        cout << "APROBADA [OK]" << endl;
+    } else {
+        cout << "REPROBADA [ERROR]" << endl;
+    }
+
+    // Las rutas Greedy ya están casi en su óptimo intra-ruta: los bloques siguientes parten
+    // de las mismas rutas con sus clientes desordenados (semilla fija)
+    mt19937 rng(1);
+    Solution solucionDesordenada(&parser);
+    for (const auto& ruta : solucionInicial.getRoutes()) {
+        vector<int> camino = ruta.getPath();
+        shuffle(camino.begin() + 1, camino.end() - 1, rng);
+        solucionDesordenada.addRoute(Route(parser.getCapacity(), &parser, camino));
+    }
+    cout << "\nCosto rutas desordenadas: " << solucionDesordenada.getTotalCost() << endl;
+
+    // 8. 3-OPT in-place: ruta por ruta igual a la implementación original por copia
+    KOpt optimizadorInPlace(&parser);
+    Solution solucionInPlace = optimizadorInPlace.optimize(solucionDesordenada);
+
+    bool igualReferencia = solucionInPlace.getRoutes().size() == solucionDesordenada.getRoutes().size();
+    for (size_t r = 0; igualReferencia && r < solucionDesordenada.getRoutes().size(); ++r) {
+        vector<int> referencia = solucionDesordenada.getRoutes()[r].getPath();
+        referenceThreeOpt(parser, referencia);
+        igualReferencia = solucionInPlace.getRoutes()[r].getPath() == referencia;
+    }
+
+    cout << "\nValidacion 3-OPT in-place = referencia por copia: ";
+    if (igualReferencia) {
+        cout << "APROBADA [OK]" << endl;
+    } else {
+        cout << "REPROBADA [ERROR]" << endl;
+    }
+
+    // 9. Or-3OPT O(L^2) con ambas políticas de aceptación
+    KOpt::Policy politicas[] = { KOpt::Policy::BestImprovement, KOpt::Policy::FirstImprovement };
+    const char*  nombres[]   = { "BestImprovement", "FirstImprovement" };
+    for (int p = 0; p < 2; ++p) {
+        KOpt optimizadorOr3(&parser);
+        optimizadorOr3.setMode(KOpt::Mode::OrThreeOpt);
+        optimizadorOr3.setPolicy(politicas[p]);
+        Solution solucionOr3 = optimizadorOr3.optimize(solucionDesordenada);
+
+        cout << "\nCosto Or-3OPT (" << nombres[p] << "): " << solucionOr3.getTotalCost() << endl;
+        cout << "Validacion Or-3OPT (" << nombres[p] << "): ";
+        if (solucionOr3.isValid() && solucionOr3.getTotalCost() <= solucionDesordenada.getTotalCost()) {
+            cout << "APROBADA [OK]" << endl;
+        } else {
+            cout << "REPROBADA [ERROR]" << endl;
+        }
+    }
+
+    // 10. Lin-Kernighan de profundidad variable
+    KOpt optimizadorLK(&parser);
+    optimizadorLK.setMode(KOpt::Mode::LinKernighan);
+    Solution solucionLK = optimizadorLK.optimize(solucionDesordenada);
+
+    cout << "\nCosto Lin-Kernighan: " << solucionLK.getTotalCost() << endl;
+    cout << "Validacion Lin-Kernighan: ";
+    if (solucionLK.isValid() && solucionLK.getTotalCost() <= solucionDesordenada.getTotalCost()) {
+        cout << "APROBADA [OK]" << endl;
+    } else {
+        cout << "REPROBADA [ERROR]" << endl;
+    }
+
     return 0;
 }
\ No newline at end of file
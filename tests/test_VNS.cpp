@@ -7,6 +7,9 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <chrono>
+#include <atomic>
+#include <vector>
 #include "Parser.h"
 #include "GreedyBuilder.h"
 #include "KOpt.h"
@@ -166,6 +169,589 @@ void testIdempotence(const Parser& parser) {
     cout << "PASS: VNS es idempotente (segunda pasada no empeora)." << endl;
 }
 
+// ─────────────────────────────────────────────────────────────
+// Test 5: Vecindades granulares
+// Restringidas a los k vecinos más cercanos, deben seguir mejorando
+// la solución inicial y entregar una solución válida.
+// ─────────────────────────────────────────────────────────────
+void testGranularNeighborhoods(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 5: VNS con vecindades granulares (k=10)" << endl;
+    cout << "========================================" << endl;
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS vns(&parser);
+    vns.setGranularity(10);
+    Solution result = vns.optimize(cw);
+
+    cout << "Costo Greedy             : " << cw.getTotalCost() << endl;
+    cout << "Costo VNS granular       : " << result.getTotalCost() << endl;
+
+    assert(result.getTotalCost() <= cw.getTotalCost() &&
+           "ERROR: VNS granular empeoro la solucion inicial.");
+
+    assert(result.isValid() &&
+           "ERROR: VNS granular produjo solucion invalida.");
+
+    cout << "PASS: VNS granular mejora y es valido." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 6: Políticas First-Improvement y Sampled
+// Con orden aleatorio de exploración deben aplicar movimientos,
+// no empeorar la solución inicial y entregar una solución válida.
+// ─────────────────────────────────────────────────────────────
+void testSearchPolicies(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 6: Politicas First-Improvement y Sampled" << endl;
+    cout << "========================================" << endl;
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS first(&parser);
+    first.setSearchPolicy(VNS::SearchPolicy::FirstImprovement);
+    Solution firstResult = first.optimize(cw);
+
+    VNS sampled(&parser);
+    sampled.setSearchPolicy(VNS::SearchPolicy::Sampled, 8);
+    Solution sampledResult = sampled.optimize(cw);
+
+    cout << "Costo First-Improvement  : " << firstResult.getTotalCost()
+         << "  (movimientos: " << first.getMovesApplied() << ")" << endl;
+    cout << "Costo Sampled (8)        : " << sampledResult.getTotalCost()
+         << "  (movimientos: " << sampled.getMovesApplied() << ")" << endl;
+
+    assert(firstResult.getTotalCost() <= cw.getTotalCost() && firstResult.isValid() &&
+           "ERROR: VNS First-Improvement empeoro o produjo solucion invalida.");
+
+    assert(sampledResult.getTotalCost() <= cw.getTotalCost() && sampledResult.isValid() &&
+           "ERROR: VNS Sampled empeoro o produjo solucion invalida.");
+
+    cout << "PASS: Politicas alternativas mejoran y son validas." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Costo de una ruta (depósito incluido) calculado directamente
+// con la matriz de distancias, sin pasar por Route
+// ─────────────────────────────────────────────────────────────
+int pathCost(const Parser& parser, const vector<int>& path) {
+    int cost = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++) cost += parser.getDistance(path[i], path[i + 1]);
+    return cost;
+}
+
+int pathLoad(const Parser& parser, const vector<int>& path) {
+    int load = 0;
+    for (int node : path) load += parser.getClients()[node].getDemand();
+    return load;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Mejor delta 2-OPT* por fuerza bruta: para cada par de rutas y
+// cada par de cortes se reconstruyen ambas rutas (intercambio de
+// colas y variante invertida) y se comparan sus costos completos.
+// ─────────────────────────────────────────────────────────────
+int bruteForceTwoOptStarDelta(const Parser& parser, const Solution& sol) {
+    const auto& routes = sol.getRoutes();
+    int Q = parser.getCapacity();
+    int best = 0;
+
+    for (size_t a = 0; a < routes.size(); a++) {
+        for (size_t b = a + 1; b < routes.size(); b++) {
+            const vector<int>& A = routes[a].getPath();
+            const vector<int>& B = routes[b].getPath();
+            int before = pathCost(parser, A) + pathCost(parser, B);
+
+            for (size_t i = 0; i + 1 < A.size(); i++) {
+                for (size_t j = 0; j + 1 < B.size(); j++) {
+                    vector<int> headA(A.begin(), A.begin() + i + 1), tailA(A.begin() + i + 1, A.end());
+                    vector<int> headB(B.begin(), B.begin() + j + 1), tailB(B.begin() + j + 1, B.end());
+
+                    vector<vector<int>> candidates[2];
+                    vector<int> x = headA, y = headB;
+                    x.insert(x.end(), tailB.begin(), tailB.end());
+                    y.insert(y.end(), tailA.begin(), tailA.end());
+                    candidates[0] = { x, y };
+
+                    x = headA;
+                    x.insert(x.end(), headB.rbegin(), headB.rend());
+                    y.assign(tailA.rbegin(), tailA.rend());
+                    y.insert(y.end(), tailB.begin(), tailB.end());
+                    candidates[1] = { x, y };
+
+                    for (const auto& pair : candidates) {
+                        if (pathLoad(parser, pair[0]) > Q || pathLoad(parser, pair[1]) > Q) continue;
+                        int delta = pathCost(parser, pair[0]) + pathCost(parser, pair[1]) - before;
+                        best = min(best, delta);
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 7: Vecindades 2-OPT* y CROSS-Exchange por sí solas
+// Un VND restringido a estas vecindades debe mejorar la solución
+// Greedy, respetar capacidades (pueden vaciar rutas) y aplicar
+// movimientos de ambas vecindades. Sobre un caso armado a mano con
+// un único movimiento 2-OPT* mejorador, la ganancia registrada debe
+// coincidir exactamente con el mejor delta calculado por fuerza bruta.
+// ─────────────────────────────────────────────────────────────
+void testTailAndCrossExchange() {
+    cout << "\n========================================" << endl;
+    cout << "TEST 7: VND con 2-OPT* y CROSS-Exchange" << endl;
+    cout << "========================================" << endl;
+
+    Parser parser("sets/X-n101-k25.vrp");
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS vns(&parser);
+    vns.setNeighborhoodOrder({ VNS::TwoOptStar, VNS::CrossExchange });
+    Solution result = vns.optimize(cw, 20);
+
+    cout << "Costo Greedy             : " << cw.getTotalCost() << endl;
+    cout << "Costo 2-OPT* + CROSS     : " << result.getTotalCost()
+         << "  (vehiculos: " << result.getRoutes().size() << ")" << endl;
+    cout << "Mejoras 2-OPT* / CROSS   : " << vns.getStats(VNS::TwoOptStar).improvements
+         << " / " << vns.getStats(VNS::CrossExchange).improvements << endl;
+
+    assert(result.getTotalCost() <= cw.getTotalCost() &&
+           "ERROR: 2-OPT*/CROSS empeoro la solucion inicial.");
+
+    assert(result.isValid() &&
+           "ERROR: 2-OPT*/CROSS produjo solucion invalida.");
+
+    assert(vns.getStats(VNS::TwoOptStar).improvements > 0 &&
+           "ERROR: 2-OPT* no aplico ningun movimiento.");
+
+    assert(vns.getStats(VNS::CrossExchange).improvements > 0 &&
+           "ERROR: CROSS-Exchange no aplico ningun movimiento.");
+
+    // Caso a mano sobre toy.vrp: rutas de a lo sumo dos clientes (3-OPT no las cambia)
+    Parser toy("sets/toy.vrp");
+    Solution fixture(&toy);
+    for (const vector<int>& path : vector<vector<int>>{ { 1, 2, 4, 1 }, { 1, 5, 6, 1 }, { 1, 3, 1 } })
+        fixture.addRoute(Route(toy.getCapacity(), &toy, path));
+
+    int expectedDelta = bruteForceTwoOptStarDelta(toy, fixture);
+
+    VNS single(&toy);
+    single.setNeighborhoodOrder({ VNS::TwoOptStar });
+    Solution moved = single.optimize(fixture, 0);
+    int actualDelta = moved.getTotalCost() - fixture.getTotalCost();
+
+    cout << "Delta 2-OPT* (caso a mano): esperado " << expectedDelta
+         << ", obtenido " << actualDelta << endl;
+
+    assert(expectedDelta < 0 && single.getStats(VNS::TwoOptStar).improvements == 1 &&
+           "ERROR: el caso a mano debia admitir exactamente un movimiento 2-OPT*.");
+
+    assert(actualDelta == expectedDelta &&
+           single.getStats(VNS::TwoOptStar).totalGain == -expectedDelta &&
+           "ERROR: la ganancia de 2-OPT* no coincide con el delta exacto.");
+
+    assert(moved.isValid() && "ERROR: el movimiento 2-OPT* produjo solucion invalida.");
+
+    cout << "PASS: 2-OPT* y CROSS-Exchange mejoran, son validos y el delta es exacto." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 8: Vecindad SWAP*
+// Sobre un mínimo local de Relocate + Swap, SWAP* sólo puede
+// mejorar el costo, debe respetar capacidades y, en una instancia
+// con rutas cargadas, encontrar al menos un movimiento.
+// ─────────────────────────────────────────────────────────────
+void testSwapStar() {
+    cout << "\n========================================" << endl;
+    cout << "TEST 8: VND con SWAP*" << endl;
+    cout << "========================================" << endl;
+
+    Parser parser("sets/X-n101-k25.vrp");
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS basic(&parser);
+    basic.setNeighborhoodOrder({ VNS::Relocate, VNS::Swap });
+    Solution local = basic.optimize(cw, 0);
+
+    VNS withSwapStar(&parser);
+    withSwapStar.setNeighborhoodOrder({ VNS::Relocate, VNS::Swap, VNS::SwapStar });
+    Solution result = withSwapStar.optimize(local, 0);
+
+    cout << "Costo Relocate + Swap    : " << local.getTotalCost() << endl;
+    cout << "Costo con SWAP*          : " << result.getTotalCost() << endl;
+    cout << "Mejoras SWAP*            : " << withSwapStar.getStats(VNS::SwapStar).improvements << endl;
+
+    assert(result.getTotalCost() <= local.getTotalCost() &&
+           "ERROR: SWAP* empeoro el minimo local.");
+
+    assert(result.isValid() &&
+           "ERROR: SWAP* produjo solucion invalida.");
+
+    assert(withSwapStar.getStats(VNS::SwapStar).improvements > 0 &&
+           "ERROR: SWAP* no aplico ningun movimiento sobre el minimo local.");
+
+    cout << "PASS: SWAP* mejora el minimo local y es valido." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 9: Cadenas de expulsión
+// Sobre un mínimo local de Relocate + Swap + SWAP*, las cadenas
+// de expulsión sólo pueden mejorar el costo y deben respetar
+// capacidades en todas las rutas que tocan. X-n101-k25 tiene un
+// llenado del 99.9%: Relocate queda bloqueado por capacidad y las
+// cadenas deben encontrar movimientos que él no alcanza.
+// ─────────────────────────────────────────────────────────────
+void testEjectionChains() {
+    cout << "\n========================================" << endl;
+    cout << "TEST 9: VND con cadenas de expulsion" << endl;
+    cout << "========================================" << endl;
+
+    Parser parser("sets/X-n101-k25.vrp");
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS basic(&parser);
+    basic.setNeighborhoodOrder({ VNS::Relocate, VNS::Swap, VNS::SwapStar });
+    Solution local = basic.optimize(cw, 0);
+
+    VNS withChains(&parser);
+    withChains.setNeighborhoodOrder({ VNS::Relocate, VNS::Swap, VNS::SwapStar, VNS::EjectionChain });
+    Solution result = withChains.optimize(local, 0);
+
+    cout << "Costo sin cadenas        : " << local.getTotalCost() << endl;
+    cout << "Costo con cadenas        : " << result.getTotalCost() << endl;
+    cout << "Mejoras por cadenas      : " << withChains.getStats(VNS::EjectionChain).improvements << endl;
+
+    assert(result.getTotalCost() <= local.getTotalCost() &&
+           "ERROR: las cadenas de expulsion empeoraron el minimo local.");
+
+    assert(result.isValid() &&
+           "ERROR: las cadenas de expulsion produjeron solucion invalida.");
+
+    assert(withChains.getStats(VNS::EjectionChain).improvements > 0 &&
+           "ERROR: las cadenas de expulsion no aplicaron ningun movimiento.");
+
+    cout << "PASS: cadenas de expulsion mejoran el minimo local y son validas." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 10: Multi-arranque paralelo con límite de tiempo
+// Cuatro trayectorias con incumbente compartido parten del mismo
+// mínimo local que optimize(x, 0), por lo que no pueden empeorarlo;
+// además deben respetar el límite de tiempo de reloj.
+// ─────────────────────────────────────────────────────────────
+void testParallelMultiStart(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 10: Multi-arranque paralelo (4 hilos, 1 s)" << endl;
+    cout << "========================================" << endl;
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS descent(&parser);
+    Solution local = descent.optimize(cw, 0);
+
+    VNS parallel(&parser);
+    parallel.setNumThreads(4);
+    parallel.setTimeLimit(1.0);
+    auto start = chrono::steady_clock::now();
+    Solution result = parallel.optimize(cw, 1000000);
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Costo VND inicial        : " << local.getTotalCost() << endl;
+    cout << "Costo multi-arranque     : " << result.getTotalCost() << endl;
+    cout << "Tiempo (s)               : " << elapsed << endl;
+
+    assert(result.getTotalCost() <= local.getTotalCost() && result.isValid() &&
+           "ERROR: el multi-arranque empeoro o produjo solucion invalida.");
+
+    assert(elapsed < 3.0 && "ERROR: el multi-arranque no respeto el limite de tiempo.");
+
+    cout << "PASS: multi-arranque paralelo mejora, es valido y respeta el tiempo." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 11: Evaluación paralela de pares de rutas
+// Repartir los pares entre hilos no debe cambiar el resultado:
+// misma solución y mismos movimientos que la evaluación secuencial.
+// Se usa una instancia con 25 rutas para superar el mínimo de pares.
+// ─────────────────────────────────────────────────────────────
+void testParallelPairEvaluation() {
+    cout << "\n========================================" << endl;
+    cout << "TEST 11: Evaluacion paralela de pares (4 hilos)" << endl;
+    cout << "========================================" << endl;
+
+    Parser parser("sets/X-n101-k25.vrp");
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS sequential(&parser);
+    Solution seqResult = sequential.optimize(cw, 10);
+
+    VNS parallel(&parser);
+    parallel.setEvaluationThreads(4);
+    Solution parResult = parallel.optimize(cw, 10);
+
+    cout << "Costo secuencial         : " << seqResult.getTotalCost()
+         << "  (movimientos: " << sequential.getMovesApplied() << ")" << endl;
+    cout << "Costo paralelo           : " << parResult.getTotalCost()
+         << "  (movimientos: " << parallel.getMovesApplied() << ")" << endl;
+
+    assert(parResult.getTotalCost() == seqResult.getTotalCost() &&
+           parallel.getMovesApplied() == sequential.getMovesApplied() &&
+           "ERROR: la evaluacion paralela cambio el resultado.");
+
+    assert(parResult.isValid() && "ERROR: la evaluacion paralela produjo solucion invalida.");
+
+    cout << "PASS: la evaluacion paralela reproduce el resultado secuencial." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 12: Parada por plazo, costo objetivo y cancelación
+// Con maxIter ilimitado, cada criterio debe detener la búsqueda;
+// el callback sólo debe recibir costos estrictamente decrecientes.
+// ─────────────────────────────────────────────────────────────
+void testStopCriteria(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 12: Plazo, objetivo y cancelacion" << endl;
+    cout << "========================================" << endl;
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+    const int UNLIMITED = 1000000000;
+
+    // Plazo de 200 ms
+    VNS timed(&parser);
+    VNS::StopCriteria byDeadline;
+    byDeadline.deadline = VNS::Clock::now() + chrono::milliseconds(200);
+    vector<double> reported;
+    auto start = chrono::steady_clock::now();
+    Solution timedResult = timed.optimize(cw, UNLIMITED, byDeadline,
+                                          [&](const Solution& s) { reported.push_back(s.getTotalCost()); });
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Plazo 200 ms             : " << timedResult.getTotalCost()
+         << " en " << elapsed << " s (" << reported.size() << " mejoras)" << endl;
+    assert(elapsed < 1.0 && timedResult.isValid() && "ERROR: el plazo no detuvo la busqueda.");
+    assert(!reported.empty() && reported.back() == timedResult.getTotalCost() &&
+           "ERROR: el callback no reporto la mejor solucion.");
+    for (size_t i = 1; i < reported.size(); i++)
+        assert(reported[i] < reported[i - 1] && "ERROR: el callback reporto un costo no mejor.");
+
+    // Costo objetivo: el de la primera mejora reportada
+    VNS targeted(&parser);
+    VNS::StopCriteria byTarget;
+    byTarget.targetCost = reported.front();
+    Solution targetResult = targeted.optimize(cw, UNLIMITED, byTarget);
+
+    cout << "Objetivo " << byTarget.targetCost << "           : " << targetResult.getTotalCost() << endl;
+    assert(targetResult.getTotalCost() <= byTarget.targetCost && targetResult.isValid() &&
+           "ERROR: el costo objetivo no detuvo la busqueda.");
+
+    // Cancelación desde el callback de la primera mejora
+    VNS cancelled(&parser);
+    atomic<bool> cancel(false);
+    VNS::StopCriteria byCancel;
+    byCancel.cancel = &cancel;
+    Solution cancelResult = cancelled.optimize(cw, UNLIMITED, byCancel,
+                                               [&](const Solution&) { cancel = true; });
+
+    cout << "Cancelado                : " << cancelResult.getTotalCost() << endl;
+    assert(cancel && cancelResult.isValid() && cancelResult.getTotalCost() <= cw.getTotalCost() &&
+           "ERROR: la cancelacion no detuvo la busqueda.");
+
+    cout << "PASS: los criterios de parada detienen la busqueda." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 13: Estadísticas por vecindad y orden adaptativo
+// Cada exploración que aplica un movimiento cuenta como una mejora,
+// así que la suma de mejoras debe coincidir con los movimientos.
+// ─────────────────────────────────────────────────────────────
+void testAdaptiveOrder(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 13: Estadisticas y orden adaptativo" << endl;
+    cout << "========================================" << endl;
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS adaptive(&parser);
+    adaptive.setAdaptiveOrder(true);
+    Solution result = adaptive.optimize(cw);
+
+    long long improvements = 0;
+    double    gain         = 0.0;
+    for (int n = 0; n < VNS::NUM_NEIGHBORHOODS; n++) {
+        const VNS::NeighborhoodStats& stats = adaptive.getStats(VNS::Neighborhood(n));
+        cout << "  Vecindad " << n << ": " << stats.evaluations << " exploraciones, "
+             << stats.improvements << " mejoras, ganancia " << stats.totalGain
+             << ", " << stats.seconds << " s" << endl;
+        assert(stats.improvements <= stats.evaluations && "ERROR: mas mejoras que exploraciones.");
+        improvements += stats.improvements;
+        gain         += stats.totalGain;
+    }
+
+    cout << "Costo adaptativo         : " << result.getTotalCost() << endl;
+
+    assert(improvements == adaptive.getMovesApplied() &&
+           "ERROR: las mejoras no coinciden con los movimientos aplicados.");
+    assert(gain > 0.0 && "ERROR: las vecindades no registraron ganancia.");
+    assert(result.getTotalCost() <= cw.getTotalCost() && result.isValid() &&
+           "ERROR: el orden adaptativo empeoro o produjo solucion invalida.");
+
+    cout << "PASS: estadisticas consistentes y orden adaptativo valido." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 14: Poda de pares de rutas por sector polar
+// Sectores disjuntos se descartan salvo que la holgura los acerque;
+// la búsqueda podada debe mejorar Greedy y ser válida, también con
+// varios hilos (cada trayectoria debe heredar la poda).
+// ─────────────────────────────────────────────────────────────
+void testSectorPruning(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 14: Poda por sectores polares" << endl;
+    cout << "========================================" << endl;
+
+    CircleSector a, b;
+    a.initialize(0);     a.extend(1000);
+    b.initialize(3000);  b.extend(4000);
+    assert(!CircleSector::overlap(a, b) && !CircleSector::overlap(b, a) &&
+           "ERROR: sectores disjuntos reportados como solapados.");
+    assert(CircleSector::overlap(a, b, 2000) && "ERROR: la holgura no ensancho el sector.");
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    VNS pruned(&parser);
+    pruned.setSectorPruning(true);
+    Solution result = pruned.optimize(cw);
+
+    // La fase inicial corre en la instancia principal; lo que pode por encima de ella
+    // corresponde a las trayectorias de los trabajadores
+    VNS initialPhase(&parser);
+    initialPhase.setSectorPruning(true);
+    initialPhase.optimize(cw, 0);
+
+    VNS prunedParallel(&parser);
+    prunedParallel.setSectorPruning(true);
+    prunedParallel.setNumThreads(4);
+    Solution parallelResult = prunedParallel.optimize(cw);
+
+    cout << "Costo Greedy             : " << cw.getTotalCost() << endl;
+    cout << "Costo con poda           : " << result.getTotalCost()
+         << "  (pares podados: " << pruned.getPrunedPairs() << ")" << endl;
+    cout << "Costo con poda (4 hilos) : " << parallelResult.getTotalCost()
+         << "  (pares podados: " << prunedParallel.getPrunedPairs()
+         << ", fase inicial: " << initialPhase.getPrunedPairs() << ")" << endl;
+
+    assert(result.getTotalCost() <= cw.getTotalCost() && result.isValid() &&
+           "ERROR: la poda por sectores empeoro o produjo solucion invalida.");
+    assert(pruned.getPrunedPairs() > 0 && "ERROR: la poda no descarto ningun par de rutas.");
+    assert(parallelResult.getTotalCost() <= cw.getTotalCost() && parallelResult.isValid() &&
+           "ERROR: la poda con varios hilos empeoro o produjo solucion invalida.");
+    assert(prunedParallel.getPrunedPairs() > initialPhase.getPrunedPairs() &&
+           "ERROR: las trayectorias paralelas no heredaron la poda por sectores.");
+
+    cout << "PASS: poda por sectores consistente y valida." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 15: Capacidad penalizada
+// Una solución sobrecargada (dos rutas fusionadas) debe repararse,
+// y la búsqueda penalizada debe devolver una solución factible, también
+// al reutilizar la instancia tras desactivar el modo.
+// ─────────────────────────────────────────────────────────────
+void testPenalizedCapacity(const Parser& parser) {
+    cout << "\n========================================" << endl;
+    cout << "TEST 15: Capacidad penalizada" << endl;
+    cout << "========================================" << endl;
+
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+    const auto& routes = cw.getRoutes();
+
+    vector<int> fused = routes[0].getPath();
+    fused.pop_back();
+    fused.insert(fused.end(), routes[1].getPath().begin() + 1, routes[1].getPath().end());
+
+    Solution overloaded(&parser);
+    overloaded.addRoute(Route(parser.getCapacity(), &parser, fused));
+    for (size_t r = 2; r < routes.size(); r++) overloaded.addRoute(routes[r]);
+
+    VNS vns(&parser);
+    vns.setPenalizedCapacity(true);
+    assert(vns.totalExcess(overloaded) > 0 && "ERROR: la fusion de rutas no excede la capacidad.");
+
+    VNS::StopCriteria stop;
+    bool repaired = vns.repairCapacity(overloaded, stop);
+    cout << "Costo reparado           : " << overloaded.getTotalCost() << endl;
+    assert(repaired && overloaded.isValid() && "ERROR: la reparacion no restauro la factibilidad.");
+
+    Solution result = vns.optimize(cw);
+    cout << "Costo Greedy             : " << cw.getTotalCost() << endl;
+    cout << "Costo penalizado         : " << result.getTotalCost()
+         << " (penalizacion " << vns.getCapacityPenalty() << ")" << endl;
+
+    assert(result.getTotalCost() <= cw.getTotalCost() && result.isValid() &&
+           "ERROR: la busqueda penalizada empeoro o produjo solucion invalida.");
+
+    // La misma instancia, de vuelta en modo factible, no debe reutilizar movimientos
+    // memorizados con el límite de carga penalizado
+    vns.setPenalizedCapacity(false);
+    Solution feasibleResult = vns.optimize(result);
+    cout << "Costo modo factible      : " << feasibleResult.getTotalCost() << endl;
+    assert(feasibleResult.getTotalCost() <= result.getTotalCost() && feasibleResult.isValid() &&
+           "ERROR: al desactivar la capacidad penalizada se obtuvo una solucion invalida.");
+
+    cout << "PASS: capacidad penalizada repara y devuelve soluciones factibles." << endl;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Test 16: La agitación no deja rutas vacías
+// En una instancia de capacidad ajustada el Shaking puede vaciar una
+// ruta; ni el resultado ni las soluciones reportadas deben incluirla.
+// ─────────────────────────────────────────────────────────────
+void testShakeRemovesEmptyRoutes() {
+    cout << "\n========================================" << endl;
+    cout << "TEST 16: Agitacion sin rutas vacias" << endl;
+    cout << "========================================" << endl;
+
+    Parser parser("sets/X-n125-k30.vrp");
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+
+    auto hasEmptyRoute = [](const Solution& sol) {
+        for (const auto& route : sol.getRoutes())
+            if (route.getPath().size() <= 2) return true;
+        return false;
+    };
+
+    VNS vns(&parser);
+    vns.setGranularity(0);
+    bool reportedEmpty = false;
+    VNS::StopCriteria stop;
+    Solution result = vns.optimize(cw, 60, stop,
+                                   [&](const Solution& s) { reportedEmpty |= hasEmptyRoute(s); });
+
+    cout << "Costo                    : " << result.getTotalCost()
+         << " (" << result.getRoutes().size() << " rutas)" << endl;
+
+    assert(!reportedEmpty && "ERROR: el callback recibio una solucion con rutas vacias.");
+    assert(!hasEmptyRoute(result) && "ERROR: la solucion final contiene rutas vacias.");
+    assert(result.isValid() && "ERROR: la agitacion produjo solucion invalida.");
+
+    cout << "PASS: la agitacion elimina las rutas que vacia." << endl;
+}
+
 // ─────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────
@@ -188,6 +774,18 @@ int main(int argc, char* argv[]) {
     testVNSNotWorse(parser);
     testFullPipeline(parser);
     testIdempotence(parser);
+    testGranularNeighborhoods(parser);
+    testSearchPolicies(parser);
+    testTailAndCrossExchange();
+    testSwapStar();
+    testEjectionChains();
+    testParallelMultiStart(parser);
+    testParallelPairEvaluation();
+    testStopCriteria(parser);
+    testAdaptiveOrder(parser);
+    testSectorPruning(parser);
+    testPenalizedCapacity(parser);
+    testShakeRemovesEmptyRoutes();
 
     cout << "\n========================================" << endl;
     cout << "  TODOS LOS TESTS PASARON" << endl;
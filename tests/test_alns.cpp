@@ -4,6 +4,10 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <vector>
+#include <random>
+#include <limits>
+#include <algorithm>
 #include "Parser.h"
 #include "GreedyBuilder.h"
 #include "VNS.h"
@@ -14,15 +18,108 @@ using namespace std;
 using chrono::steady_clock;
 using chrono::duration;
 
+// ─────────────────────────────────────────────────────────────
+// Puntaje de referencia con que regret-k debería elegir al primer cliente
+// a insertar en la solución parcial (rutas sin los clientes removidos).
+// ─────────────────────────────────────────────────────────────
+double referenceScore(const Parser& parser, const vector<vector<int>>& paths,
+                      const vector<int>& loads, int client, int regretK) {
+    int demand = parser.getClients()[client].getDemand();
+    vector<int> deltas;
+    for (size_t r = 0; r < paths.size(); r++) {
+        if (loads[r] + demand > parser.getCapacity()) continue;
+        int best = numeric_limits<int>::max();
+        for (size_t p = 1; p < paths[r].size(); p++) {
+            int a = paths[r][p - 1], b = paths[r][p];
+            best = min(best, parser.getDistance(a, client) + parser.getDistance(client, b)
+                             - parser.getDistance(a, b));
+        }
+        deltas.push_back(best);
+    }
+    if (deltas.empty()) return numeric_limits<double>::infinity();
+    sort(deltas.begin(), deltas.end());
+    if (regretK == 1) return -deltas[0];
+
+    int newRouteCost = 2 * parser.getDistance(1, client);
+    double regret = 0.0;
+    for (int j = 1; j < regretK; j++) {
+        int dj = (j < (int)deltas.size()) ? deltas[j] : max(deltas[0], newRouteCost);
+        regret += dj - deltas[0];
+    }
+    return regret;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Reparaciones heurísticas (greedy, regret-2, regret-3) sin CBC:
+// la solución reparada debe ser factible, cada cliente removido debe
+// insertarse exactamente una vez y el primero en insertarse debe ser
+// el de mayor puntaje regret-k.
+// ─────────────────────────────────────────────────────────────
+bool testHeuristicRepairs(const Parser& parser, ALNS& alns, const Solution& base) {
+    mt19937 rng(7);
+    int k = max(2, min(15, (parser.getDimension() - 1) / 4));
+
+    for (int trial = 0; trial < 20; trial++) {
+        vector<int> clients;
+        for (int id = 2; id <= parser.getDimension(); id++) clients.push_back(id);
+        shuffle(clients.begin(), clients.end(), rng);
+        vector<int> removed(clients.begin(), clients.begin() + k);
+        vector<bool> isRemoved(parser.getDimension() + 1, false);
+        for (int c : removed) isRemoved[c] = true;
+
+        vector<vector<int>> paths;
+        vector<int>         loads;
+        for (const auto& route : base.getRoutes()) {
+            vector<int> path;
+            int load = 0;
+            for (int id : route.getPath()) {
+                if (isRemoved[id]) continue;
+                path.push_back(id);
+                if (id != 1) load += parser.getClients()[id].getDemand();
+            }
+            if (path.size() > 2) { paths.push_back(path); loads.push_back(load); }
+        }
+
+        for (int regretK = 1; regretK <= 3; regretK++) {
+            vector<int> order;
+            Solution repaired = alns.regretRepair(base, removed, regretK, &order);
+
+            if (!repaired.isValid()) {
+                cout << "FAIL: regret-" << regretK << " produjo una solucion invalida.\n";
+                return false;
+            }
+            vector<int> sortedOrder = order, sortedRemoved = removed;
+            sort(sortedOrder.begin(), sortedOrder.end());
+            sort(sortedRemoved.begin(), sortedRemoved.end());
+            if (sortedOrder != sortedRemoved) {
+                cout << "FAIL: regret-" << regretK << " no inserto cada cliente removido una vez.\n";
+                return false;
+            }
+
+            double bestScore = -numeric_limits<double>::infinity();
+            for (int c : removed) bestScore = max(bestScore, referenceScore(parser, paths, loads, c, regretK));
+            if (referenceScore(parser, paths, loads, order.front(), regretK) != bestScore) {
+                cout << "FAIL: regret-" << regretK << " no eligio primero al cliente de mayor puntaje.\n";
+                return false;
+            }
+        }
+    }
+
+    cout << "Reparaciones greedy/regret-2/regret-3: validas en 20 destrucciones de " << k << " clientes.\n";
+    return true;
+}
+
 int main(int argc, char* argv[]) {
 
     string filename = (argc > 1) ? argv[1] : "sets/A-n32-k5.vrp";
     double totalTime    = (argc > 2) ? stod(argv[2]) : 60.0;
+    int    numThreads   = (argc > 3) ? stoi(argv[3]) : 1;
 
     cout << "========================================\n";
     cout << "  TEST LNS-MIP (ALNS + CBC Subproblema)\n";
     cout << "  Instancia  : " << filename          << "\n";
     cout << "  Tiempo total: " << totalTime << "s\n";
+    cout << "  Hilos ALNS : " << numThreads << "\n";
     cout << "========================================\n";
 
     // ── 1. Cargar instancia ───────────────────────────────────────────────
@@ -55,8 +152,11 @@ int main(int argc, char* argv[]) {
     int destroySize = max(5, min(20, n / 6)); // ~16% de los clientes
     alns.setDestroySize(destroySize);
     alns.setVnsIterations(10);
+    alns.setNumThreads(numThreads);
     cout << "[ALNS] destroySize=" << destroySize << "\n\n";
 
+    if (!testHeuristicRepairs(parser, alns, vnsSol)) return 1;
+
     Solution alnsSol = alns.optimize(vnsSol, totalTime);
 
     // ── 5. VNS final ─────────────────────────────────────────────────────
@@ -0,0 +1,198 @@
+// test_hgs.cpp
+// Pipeline: CW → HGS (OX + Split + educación VNS)
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include "Parser.h"
+#include "GreedyBuilder.h"
+#include "HGS.h"
+
+using namespace std;
+using chrono::steady_clock;
+using chrono::duration;
+
+// ─────────────────────────────────────────────────────────────
+// Costo penalizado de una solución calculado desde sus rutas
+// ─────────────────────────────────────────────────────────────
+double penalizedCost(const Parser& parser, const Solution& sol, double penalty) {
+    double cost = 0.0;
+    for (const auto& route : sol.getRoutes()) {
+        const vector<int>& path = route.getPath();
+        int load = 0;
+        for (size_t i = 0; i + 1 < path.size(); i++) {
+            cost += parser.getDistance(path[i], path[i + 1]);
+            load += parser.getClients()[path[i]].getDemand();
+        }
+        cost += penalty * max(0, load - parser.getCapacity());
+    }
+    return cost;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Mejor corte de un tour gigante por fuerza bruta: prueba todas
+// las combinaciones de cortes con las mismas reglas que Split
+// (carga hasta 1.5 Q salvo rutas de un cliente, exceso penalizado)
+// ─────────────────────────────────────────────────────────────
+double bruteForceSplit(const Parser& parser, const vector<int>& tour, double penalty) {
+    int n = tour.size();
+    int Q = parser.getCapacity();
+    double best = INFINITY;
+
+    for (int mask = 0; mask < (1 << (n - 1)); mask++) {
+        double cost = 0.0;
+        bool   ok   = true;
+        int    begin = 0;
+        for (int i = 0; i < n && ok; i++) {
+            if (i < n - 1 && !(mask & (1 << i))) continue;
+            int load = 0;
+            cost += parser.getDistance(1, tour[begin]) + parser.getDistance(tour[i], 1);
+            for (int k = begin; k <= i; k++) {
+                load += parser.getClients()[tour[k]].getDemand();
+                if (k > begin) cost += parser.getDistance(tour[k - 1], tour[k]);
+            }
+            if (i > begin && load > 1.5 * Q) ok = false;
+            cost += penalty * max(0, load - Q);
+            begin = i + 1;
+        }
+        if (ok) best = min(best, cost);
+    }
+    return best;
+}
+
+// ─────────────────────────────────────────────────────────────
+// Pruebas directas de los operadores: Split óptimo, OX produce
+// permutaciones con material de ambos padres y la distancia de
+// pares rotos es 0 entre soluciones iguales (aun invertidas).
+// ─────────────────────────────────────────────────────────────
+bool testOperators(const Parser& parser) {
+    HGS hgs(&parser);
+    mt19937 rng(7);
+
+    // Split sobre los primeros 12 clientes en orden aleatorio
+    vector<int> tour(min(12, parser.getDimension() - 1));
+    iota(tour.begin(), tour.end(), 2);
+    shuffle(tour.begin(), tour.end(), rng);
+    Solution splitSol = hgs.split(tour);
+    double splitCost  = penalizedCost(parser, splitSol, hgs.getCapacityPenalty());
+    double optimal    = bruteForceSplit(parser, tour, hgs.getCapacityPenalty());
+    cout << "Split            : " << splitCost << " (optimo por fuerza bruta: " << optimal << ")\n";
+    if (fabs(splitCost - optimal) > 1e-6) {
+        cout << "FAIL: Split no devolvio el corte optimo.\n";
+        return false;
+    }
+
+    // OX: el segundo padre es el primero rotado, así que no comparten ninguna posición
+    vector<int> parent1(parser.getDimension() - 1);
+    iota(parent1.begin(), parent1.end(), 2);
+    for (int trial = 0; trial < 500; trial++) {
+        shuffle(parent1.begin(), parent1.end(), rng);
+        vector<int> parent2(parent1.begin() + 1, parent1.end());
+        parent2.push_back(parent1[0]);
+
+        vector<int> child = hgs.crossoverOX(parent1, parent2);
+        vector<int> sorted = child;
+        sort(sorted.begin(), sorted.end());
+        vector<int> expected(parent1.size());
+        iota(expected.begin(), expected.end(), 2);
+        if (sorted != expected) {
+            cout << "FAIL: OX no produjo una permutacion de los clientes.\n";
+            return false;
+        }
+        if (child == parent2) {
+            cout << "FAIL: OX devolvio una copia del segundo padre.\n";
+            return false;
+        }
+    }
+    cout << "OX               : 500 hijos son permutaciones distintas del segundo padre\n";
+
+    // Distancia de pares rotos
+    GreedyBuilder builder(&parser);
+    Solution cw = builder.buildSolution();
+    Solution reversed(&parser);
+    for (const auto& route : cw.getRoutes()) {
+        vector<int> path = route.getPath();
+        reverse(path.begin(), path.end());
+        reversed.addRoute(Route(parser.getCapacity(), &parser, path));
+    }
+    double same     = hgs.brokenPairsDistance(cw, cw);
+    double inverted = hgs.brokenPairsDistance(cw, reversed);
+    double other    = hgs.brokenPairsDistance(cw, hgs.split(parent1));
+    cout << "Pares rotos      : identica " << same << ", invertida " << inverted
+         << ", distinta " << other << "\n";
+    if (same != 0.0 || inverted != 0.0 || other <= 0.0) {
+        cout << "FAIL: distancia de pares rotos incorrecta.\n";
+        return false;
+    }
+
+    cout << "PASS: operadores de HGS.\n\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+
+    string filename  = (argc > 1) ? argv[1] : "sets/A-n32-k5.vrp";
+    double totalTime = (argc > 2) ? stod(argv[2]) : 3.0;
+
+    cout << "========================================\n";
+    cout << "  TEST HGS (Hybrid Genetic Search)\n";
+    cout << "  Instancia  : " << filename          << "\n";
+    cout << "  Tiempo total: " << totalTime << "s\n";
+    cout << "========================================\n";
+
+    // ── 1. Cargar instancia ───────────────────────────────────────────────
+    Parser parser(filename);
+    cout << "Instancia cargada: N=" << parser.getDimension()
+         << " Q=" << parser.getCapacity() << "\n\n";
+
+    if (!testOperators(parser)) return 1;
+
+    auto t0 = steady_clock::now();
+
+    // ── 2. Clarke-Wright ──────────────────────────────────────────────────
+    GreedyBuilder builder(&parser);
+    Solution cwSol = builder.buildSolution();
+    cout << "Clarke-Wright    : " << cwSol.getTotalCost() << "\n\n";
+
+    // ── 3. HGS ────────────────────────────────────────────────────────────
+    HGS hgs(&parser);
+    Solution hgsSol = hgs.optimize(cwSol, totalTime);
+
+    double totalElapsed = duration<double>(steady_clock::now() - t0).count();
+
+    // ── 4. Reporte ────────────────────────────────────────────────────────
+    cout << "\n========================================\n";
+    cout << "  RESUMEN\n";
+    cout << "========================================\n";
+    cout << "Clarke-Wright    : " << cwSol.getTotalCost()  << "\n";
+    cout << "HGS              : " << hgsSol.getTotalCost() << "\n";
+    cout << "Mejora total     : "
+         << cwSol.getTotalCost() - hgsSol.getTotalCost()
+         << "  ("
+         << 100.0 * (cwSol.getTotalCost() - hgsSol.getTotalCost())
+                  / cwSol.getTotalCost()
+         << "%)\n";
+    cout << "Tiempo total     : " << totalElapsed << "s\n";
+
+    // Validación
+    if (!hgsSol.isValid()) {
+        cout << "\nFAIL: Solucion final invalida.\n";
+        return 1;
+    }
+    if (hgsSol.getTotalCost() > cwSol.getTotalCost()) {
+        cout << "\nFAIL: HGS empeoro la solucion inicial.\n";
+        return 1;
+    }
+    if (totalElapsed > totalTime + 2.0) {
+        cout << "\nFAIL: HGS excedio el limite de tiempo.\n";
+        return 1;
+    }
+
+    cout << "\nPASS: Solucion valida.\n";
+    return 0;
+}
\ No newline at end of file
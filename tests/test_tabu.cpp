@@ -0,0 +1,86 @@
+// test_tabu.cpp
+// Pipeline: CW → Búsqueda tabú granular
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "Parser.h"
+#include "GreedyBuilder.h"
+#include "TabuSearch.h"
+
+using namespace std;
+using chrono::steady_clock;
+using chrono::duration;
+
+int main(int argc, char* argv[]) {
+
+    string filename  = (argc > 1) ? argv[1] : "sets/A-n32-k5.vrp";
+    double totalTime = (argc > 2) ? stod(argv[2]) : 3.0;
+
+    cout << "========================================\n";
+    cout << "  TEST TABU (Busqueda Tabu Granular)\n";
+    cout << "  Instancia  : " << filename          << "\n";
+    cout << "  Tiempo total: " << totalTime << "s\n";
+    cout << "========================================\n";
+
+    // ── 1. Cargar instancia ───────────────────────────────────────────────
+    Parser parser(filename);
+    cout << "Instancia cargada: N=" << parser.getDimension()
+         << " Q=" << parser.getCapacity() << "\n\n";
+
+    // ── 2. Clarke-Wright ──────────────────────────────────────────────────
+    GreedyBuilder builder(&parser);
+    Solution cwSol = builder.buildSolution();
+    cout << "Clarke-Wright    : " << cwSol.getTotalCost() << "\n\n";
+
+    // ── 3. Determinismo: dos corridas acotadas por iteraciones ───────────
+    TabuSearch first(&parser);
+    first.setMaxIterations(2000);
+    Solution firstSol = first.optimize(cwSol, 0.0);
+
+    TabuSearch second(&parser);
+    second.setMaxIterations(2000);
+    Solution secondSol = second.optimize(cwSol, 0.0);
+
+    bool sameRoutes = firstSol.getRoutes().size() == secondSol.getRoutes().size();
+    for (size_t r = 0; sameRoutes && r < firstSol.getRoutes().size(); r++)
+        sameRoutes = firstSol.getRoutes()[r].getPath() == secondSol.getRoutes()[r].getPath();
+
+    if (!sameRoutes || firstSol.getTotalCost() != secondSol.getTotalCost()) {
+        cout << "\nFAIL: Dos corridas con la misma semilla difieren.\n";
+        return 1;
+    }
+
+    // ── 4. Corrida con límite de tiempo ───────────────────────────────────
+    auto t0 = steady_clock::now();
+    TabuSearch tabu(&parser);
+    Solution tabuSol = tabu.optimize(cwSol, totalTime);
+    double totalElapsed = duration<double>(steady_clock::now() - t0).count();
+
+    // ── 5. Reporte ────────────────────────────────────────────────────────
+    cout << "\n========================================\n";
+    cout << "  RESUMEN\n";
+    cout << "========================================\n";
+    cout << "Clarke-Wright    : " << cwSol.getTotalCost()   << "\n";
+    cout << "Tabu (2000 iter) : " << firstSol.getTotalCost() << "\n";
+    cout << "Tabu (tiempo)    : " << tabuSol.getTotalCost() << "\n";
+    cout << "Iteraciones      : " << tabu.getIterations()   << "\n";
+    cout << "Tiempo total     : " << totalElapsed << "s\n";
+
+    // Validación
+    if (!firstSol.isValid() || !tabuSol.isValid()) {
+        cout << "\nFAIL: Solucion final invalida.\n";
+        return 1;
+    }
+    if (tabuSol.getTotalCost() > cwSol.getTotalCost()) {
+        cout << "\nFAIL: La busqueda tabu empeoro la solucion inicial.\n";
+        return 1;
+    }
+    if (totalElapsed > totalTime + 2.0) {
+        cout << "\nFAIL: La busqueda tabu excedio el limite de tiempo.\n";
+        return 1;
+    }
+
+    cout << "\nPASS: Solucion valida y determinista.\n";
+    return 0;
+}
\ No newline at end of file